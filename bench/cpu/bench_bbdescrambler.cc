@@ -0,0 +1,105 @@
+/* -*- c++ -*- */
+/*
+ * Copyright (c) 2024 Igor Freire.
+ *
+ * This file is part of gr-dvbs2rx.
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#include "bb_descrambler.h"
+#include <benchmark/benchmark.h>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace gr::dvbs2rx;
+
+namespace {
+
+// Descrambling methods
+enum descramble_method_t { DESCRAMBLE_BYTEWISE, DESCRAMBLE_WIDE, DESCRAMBLE_INPLACE };
+
+const char* descramble_method_names[] = { "bytewise", "wide", "inplace" };
+
+struct bbframe_len_t {
+    const char* name;
+    unsigned int kbch_bytes;
+};
+
+// Shortest and longest BBFRAMEs, plus one with an odd length
+const bbframe_len_t bbframe_lens[] = {
+    { "short_1/4", 384 },
+    { "normal_1/4", 2001 },
+    { "normal_9/10", 7274 },
+};
+
+} // namespace
+
+/**
+ * @brief Benchmark the BB descrambling of a buffer of consecutive BBFRAMEs.
+ *
+ * The bytewise method is the former byte-by-byte XOR loop, kept here as the reference.
+ * The wide method XORs the BBFRAMEs into another buffer using the widest SIMD registers
+ * available, and the in-place method does the same over the input buffer.
+ */
+static void
+BM_bb_descramble(benchmark::State& state, descramble_method_t method, bbframe_len_t len)
+{
+    const int n_bbframes = 16;
+    const unsigned int kbch_bytes = len.kbch_bytes;
+    bb_descrambler descrambler(kbch_bytes);
+
+    // Descrambling sequence for the reference loop
+    std::vector<unsigned char> derandomise(kbch_bytes, 0);
+    descrambler.descramble(derandomise.data());
+
+    std::vector<unsigned char> in(n_bbframes * kbch_bytes);
+    std::vector<unsigned char> out(n_bbframes * kbch_bytes);
+    std::mt19937 gen(0);
+    for (auto& byte : in)
+        byte = gen();
+
+    for (auto _ : state) {
+        for (int i = 0; i < n_bbframes; i++) {
+            unsigned char* p_in = in.data() + i * kbch_bytes;
+            unsigned char* p_out = out.data() + i * kbch_bytes;
+            switch (method) {
+            case DESCRAMBLE_BYTEWISE:
+                for (unsigned int j = 0; j < kbch_bytes; j++)
+                    p_out[j] = p_in[j] ^ derandomise[j];
+                break;
+            case DESCRAMBLE_WIDE:
+                descrambler.descramble(p_in, p_out);
+                break;
+            default:
+                descrambler.descramble(p_in);
+            }
+        }
+        benchmark::DoNotOptimize(in.data());
+        benchmark::DoNotOptimize(out.data());
+        benchmark::ClobberMemory();
+    }
+
+    state.SetBytesProcessed(state.iterations() * n_bbframes * kbch_bytes);
+    state.counters["frames/s"] = benchmark::Counter(state.iterations() * n_bbframes,
+                                                    benchmark::Counter::kIsRate);
+}
+
+int main(int argc, char** argv)
+{
+    for (const auto& len : bbframe_lens) {
+        for (int method = DESCRAMBLE_BYTEWISE; method <= DESCRAMBLE_INPLACE; method++) {
+            const std::string name = std::string("BM_bb_descramble/") +
+                                     descramble_method_names[method] + "/" + len.name;
+            benchmark::RegisterBenchmark(name.c_str(),
+                                         BM_bb_descramble,
+                                         static_cast<descramble_method_t>(method),
+                                         len);
+        }
+    }
+    benchmark::Initialize(&argc, argv);
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    return 0;
+}
@@ -0,0 +1,118 @@
+/* -*- c++ -*- */
+/*
+ * Copyright (c) 2024 Igor Freire.
+ *
+ * This file is part of gr-dvbs2rx.
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#include "bch.h"
+#include "gf_util.h"
+#include <benchmark/benchmark.h>
+#include <random>
+#include <string>
+
+using namespace gr::dvbs2rx;
+
+namespace {
+
+// Remainder computation methods
+enum rem_method_t { REM_BYTEWISE, REM_BATCH, REM_SLICE4, REM_SLICE8, REM_CLMUL };
+
+const char* rem_method_names[] = { "bytewise", "batch", "slice4", "slice8", "clmul" };
+
+struct bch_code_t {
+    const char* name;
+    uint32_t prim_poly;
+    uint32_t n;
+    uint8_t t;
+};
+
+// Codes with the longest codeword (and generator polynomial) of each FECFRAME size
+const bch_code_t bch_codes[] = {
+    { "normal_9/10", 0b10000000000101101, 58320, 8 },
+    { "normal_1/2", 0b10000000000101101, 32400, 12 },
+    { "short_8/9", 0b100000000101011, 14400, 12 },
+};
+
+} // namespace
+
+/**
+ * @brief Benchmark the remainder of the division of codewords by the BCH generator
+ * polynomial, the first step of every BCH decoding.
+ *
+ * Each iteration computes the remainders of a batch of codewords, either one codeword
+ * at a time (bytewise, slice-by-N, and folding methods) or in lockstep (batch method).
+ */
+static void BM_gf2_poly_rem(benchmark::State& state, rem_method_t method, bch_code_t code)
+{
+    if (method == REM_CLMUL && !gf2_clmul_supported()) {
+        state.SkipWithError("Carry-less multiplication not supported");
+        return;
+    }
+
+    galois_field<uint32_t> gf(code.prim_poly);
+    bch_codec<uint32_t, bitset256_t> codec(&gf, code.t, code.n);
+    const auto& g = codec.get_gen_poly();
+    const auto rem_lut = build_gf2_poly_rem_lut(g);
+    const auto rem_word_lut = build_gf2_poly_rem_word_lut(g);
+    const auto rem_slice4_lut = build_gf2_poly_rem_slice_lut(g, 4);
+    const auto rem_slice8_lut = build_gf2_poly_rem_slice_lut(g, 8);
+    const auto rem_clmul_consts = build_gf2_poly_rem_clmul_consts(g);
+
+    const int n_codewords = 16;
+    const int n_bytes = code.n / 8;
+    u8_vector_t codewords(n_codewords * n_bytes);
+    std::mt19937 gen(0);
+    for (auto& byte : codewords)
+        byte = gen();
+    std::vector<gf2_poly<bitset256_t>> rem(n_codewords, gf2_poly<bitset256_t>(0));
+
+    for (auto _ : state) {
+        if (method == REM_BATCH) {
+            gf2_poly_rem_batch(
+                codewords.data(), n_bytes, n_codewords, g, rem_word_lut, rem.data());
+        } else {
+            for (int i = 0; i < n_codewords; i++) {
+                u8_cptr_t y = codewords.data() + i * n_bytes;
+                switch (method) {
+                case REM_BYTEWISE:
+                    rem[i] = gf2_poly_rem(y, n_bytes, g, rem_lut);
+                    break;
+                case REM_SLICE4:
+                    rem[i] = gf2_poly_rem_slice(y, n_bytes, g, rem_slice4_lut);
+                    break;
+                case REM_SLICE8:
+                    rem[i] = gf2_poly_rem_slice(y, n_bytes, g, rem_slice8_lut);
+                    break;
+                default:
+                    rem[i] = gf2_poly_rem_clmul(
+                        y, n_bytes, g, rem_clmul_consts, rem_word_lut);
+                }
+            }
+        }
+        benchmark::DoNotOptimize(rem.data());
+        benchmark::ClobberMemory();
+    }
+
+    state.SetBytesProcessed(state.iterations() * n_codewords * n_bytes);
+    state.counters["frames/s"] = benchmark::Counter(
+        state.iterations() * n_codewords, benchmark::Counter::kIsRate);
+}
+
+int main(int argc, char** argv)
+{
+    for (const auto& code : bch_codes) {
+        for (int method = REM_BYTEWISE; method <= REM_CLMUL; method++) {
+            const std::string name = std::string("BM_gf2_poly_rem/") +
+                                     rem_method_names[method] + "/" + code.name;
+            benchmark::RegisterBenchmark(
+                name.c_str(), BM_gf2_poly_rem, static_cast<rem_method_t>(method), code);
+        }
+    }
+    benchmark::Initialize(&argc, argv);
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    return 0;
+}
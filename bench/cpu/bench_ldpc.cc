@@ -0,0 +1,585 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2024 Igor Freire.
+ *
+ * This file is part of gr-dvbs2rx.
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#include "cpu_features_macros.h"
+#include "dvb_s2_tables.hh"
+#include "dvb_s2x_tables.hh"
+#include "ldpc_decoder/ldpc_decoder_isa.hh"
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#ifdef CPU_FEATURES_ARCH_ARM
+#include "cpuinfo_arm.h"
+using namespace cpu_features;
+#endif
+
+#ifdef CPU_FEATURES_ARCH_X86
+#include "cpuinfo_x86.h"
+using namespace cpu_features;
+#endif
+
+/**
+ * @brief Stream decoding entry points of a decoder variant (schedule and precision).
+ */
+struct ldpc_stream_api_t {
+    void* (*create)(LDPCInterface*, const ldpc_min_sum_t&);
+    void (*destroy)(void*);
+    int (*decode_stream)(void*, void*, const int8_t*, int8_t*, int, int, int*);
+};
+
+/**
+ * @brief LDPC decoder implementation under test.
+ */
+struct ldpc_isa_t {
+    const char* name;
+    int simd_size;
+    bool (*supported)();
+    int (*decode)(void*, void*, int8_t*, int, int); // layered decoder's batch decoding
+    void (*pack)(const int8_t*, uint8_t*, int);
+    ldpc_stream_api_t layered;  // layered schedule with 8-bit precision
+    ldpc_stream_api_t flooding; // flooding schedule with 8-bit precision
+    ldpc_stream_api_t int16;    // layered schedule with 16-bit precision
+};
+
+// Entry points of the implementation on a given namespace
+#define LDPC_ISA(ns, name, simd_size, supported)                                      \
+    {                                                                                 \
+        name, simd_size, supported, ns::ldpc_dec_decode, ns::ldpc_dec_pack,           \
+            { ns::ldpc_dec_create, ns::ldpc_dec_destroy, ns::ldpc_dec_decode_stream }, \
+            { ns::ldpc_dec_create_flooding,                                           \
+              ns::ldpc_dec_destroy_flooding,                                          \
+              ns::ldpc_dec_decode_stream_flooding },                                  \
+            { ns::ldpc_dec_create_int16,                                              \
+              ns::ldpc_dec_destroy_int16,                                             \
+              ns::ldpc_dec_decode_stream_int16 }                                      \
+    }
+
+static bool always() { return true; }
+static const ldpc_isa_t isa_generic = LDPC_ISA(ldpc_generic, "generic", 16, always);
+
+#ifdef CPU_FEATURES_ARCH_X86
+static bool has_sse41() { return GetX86Info().features.sse4_1; }
+static bool has_avx2() { return GetX86Info().features.avx2; }
+static bool has_avx512bw() { return GetX86Info().features.avx512bw; }
+
+static const ldpc_isa_t isa_sse41 = LDPC_ISA(ldpc_sse41, "sse41", 16, has_sse41);
+static const ldpc_isa_t isa_avx2 = LDPC_ISA(ldpc_avx2, "avx2", 32, has_avx2);
+static const ldpc_isa_t isa_avx512 = LDPC_ISA(ldpc_avx512, "avx512", 64, has_avx512bw);
+#endif
+
+#ifdef CPU_FEATURES_ARCH_ANY_ARM
+#ifdef CPU_FEATURES_ARCH_AARCH64
+static bool has_neon() { return true; } // always available on aarch64
+#else
+static bool has_neon() { return GetArmInfo().features.neon; }
+#endif
+
+static const ldpc_isa_t isa_neon = LDPC_ISA(ldpc_neon, "neon", 16, has_neon);
+#endif
+
+/**
+ * @brief Generate int8 LLRs for BPSK-modulated all-zero codewords over AWGN.
+ *
+ * The all-zero word is a codeword of any linear code, so no encoder is required.
+ *
+ * @param llr Output LLR vector, whose size determines the number of LLRs.
+ * @param esn0_db Es/N0 in dB.
+ * @param gain Scaling factor applied to the LLRs before the int8 quantization.
+ */
+static void gen_llrs(std::vector<int8_t>& llr, double esn0_db, double gain = 1.0)
+{
+    std::mt19937 rng(42);
+    const double sigma2 = 1.0 / (2 * std::pow(10.0, esn0_db / 10));
+    std::normal_distribution<double> noise(0.0, std::sqrt(sigma2));
+    for (auto& x : llr) {
+        const double y = 1.0 + noise(rng);
+        const double l = std::nearbyint(gain * 2 * y / sigma2);
+        x = static_cast<int8_t>(std::min(std::max(l, -127.0), 127.0));
+    }
+}
+
+/**
+ * @brief Benchmark the decoding of SIMD batches of LDPC frames.
+ *
+ * Reports the decoded frames per second, the information throughput, and the average
+ * number of decoding iterations per batch.
+ *
+ * @param state Benchmark state.
+ * @param isa LDPC decoder implementation.
+ * @param code LDPC code.
+ * @param esn0_db Es/N0 in dB.
+ */
+static void BM_ldpc_decode(benchmark::State& state,
+                           const ldpc_isa_t& isa,
+                           std::shared_ptr<LDPCInterface> code,
+                           double esn0_db)
+{
+    const int max_trials = 25;
+    const int n = code->code_len();
+    void* dec = isa.layered.create(code.get(), ldpc_min_sum_t());
+    void* buffer = aligned_alloc(isa.simd_size, isa.simd_size * n);
+    std::vector<int8_t> llr(isa.simd_size * n);
+    std::vector<int8_t> soft(llr.size());
+    gen_llrs(llr, esn0_db);
+
+    int64_t n_trials = 0;
+    for (auto _ : state) {
+        state.PauseTiming();
+        soft = llr; // the decoder works in place
+        state.ResumeTiming();
+        const int count = isa.decode(dec, buffer, soft.data(), max_trials, isa.simd_size);
+        n_trials += (count < 0) ? max_trials : (max_trials - count);
+    }
+
+    const double n_frames = state.iterations() * isa.simd_size;
+    state.counters["frames/s"] =
+        benchmark::Counter(n_frames, benchmark::Counter::kIsRate);
+    state.counters["Mbps"] = benchmark::Counter(n_frames * code->data_len() / 1e6,
+                                                benchmark::Counter::kIsRate);
+    state.counters["iterations"] =
+        benchmark::Counter(n_trials, benchmark::Counter::kAvgIterations);
+
+    free(buffer);
+    isa.layered.destroy(dec);
+}
+
+/**
+ * @brief Decode a stream of LDPC frames with lane recycling, as the decoder block does.
+ *
+ * Each frame leaves its SIMD lane as soon as it converges, and the next frame in the
+ * stream takes over the lane. Reports the decoded frames per second, the information
+ * throughput, the average number of iterations per frame, and the frame error rate.
+ *
+ * @param state Benchmark state.
+ * @param isa LDPC decoder implementation.
+ * @param api Entry points of the decoder variant under test.
+ * @param min_sum Check node update rule.
+ * @param code LDPC code.
+ * @param esn0_db Es/N0 in dB.
+ * @param gain LLR gain (see gen_llrs()).
+ * @param n_batches Number of SIMD batches per stream.
+ */
+static void bench_stream(benchmark::State& state,
+                         const ldpc_isa_t& isa,
+                         const ldpc_stream_api_t& api,
+                         const ldpc_min_sum_t& min_sum,
+                         std::shared_ptr<LDPCInterface> code,
+                         double esn0_db,
+                         double gain = 1.0,
+                         int n_batches = 4)
+{
+    const int max_trials = 25;
+    const int n = code->code_len();
+    const int n_stream = n_batches * isa.simd_size; // frames per stream
+    void* dec = api.create(code.get(), min_sum);
+    void* buffer = aligned_alloc(isa.simd_size, isa.simd_size * n);
+    std::vector<int8_t> llr(n_stream * n);
+    std::vector<int8_t> soft(llr.size());
+    std::vector<int> counts(n_stream);
+    gen_llrs(llr, esn0_db, gain);
+
+    int64_t n_trials = 0, n_failed = 0;
+    for (auto _ : state) {
+        api.decode_stream(
+            dec, buffer, llr.data(), soft.data(), max_trials, n_stream, counts.data());
+        for (int count : counts) {
+            n_trials += (count < 0) ? max_trials : (max_trials - count);
+            n_failed += (count < 0);
+        }
+    }
+
+    const double n_frames = state.iterations() * n_stream;
+    state.counters["frames/s"] =
+        benchmark::Counter(n_frames, benchmark::Counter::kIsRate);
+    state.counters["Mbps"] = benchmark::Counter(n_frames * code->data_len() / 1e6,
+                                                benchmark::Counter::kIsRate);
+    state.counters["iterations"] = n_trials / n_frames;
+    state.counters["FER"] = n_failed / n_frames;
+
+    free(buffer);
+    api.destroy(dec);
+}
+
+/**
+ * @brief Benchmark the decoding of a stream of 16 SIMD batches with lane recycling.
+ *
+ * Compared to BM_ldpc_decode, the iterations are averaged per frame rather than per
+ * batch. See bench_stream().
+ *
+ * @param state Benchmark state.
+ * @param isa LDPC decoder implementation.
+ * @param code LDPC code.
+ * @param esn0_db Es/N0 in dB.
+ */
+static void BM_ldpc_decode_stream(benchmark::State& state,
+                                  const ldpc_isa_t& isa,
+                                  std::shared_ptr<LDPCInterface> code,
+                                  double esn0_db)
+{
+    bench_stream(state, isa, isa.layered, ldpc_min_sum_t(), code, esn0_db, 1.0, 16);
+}
+
+/**
+ * @brief Benchmark the layered and flooding decoding schedules.
+ *
+ * With the flooding schedule, the iterations are those of the SIMD batch holding each
+ * frame. See bench_stream().
+ *
+ * @param state Benchmark state.
+ * @param isa LDPC decoder implementation.
+ * @param flooding Whether to use the flooding schedule instead of the layered one.
+ * @param code LDPC code.
+ * @param esn0_db Es/N0 in dB.
+ */
+static void BM_ldpc_schedule(benchmark::State& state,
+                             const ldpc_isa_t& isa,
+                             bool flooding,
+                             std::shared_ptr<LDPCInterface> code,
+                             double esn0_db)
+{
+    const ldpc_stream_api_t& api = flooding ? isa.flooding : isa.layered;
+    bench_stream(state, isa, api, ldpc_min_sum_t(), code, esn0_db);
+}
+
+/**
+ * @brief Benchmark the 8-bit and 16-bit precision decoders.
+ *
+ * The 16-bit decoder trades half of the SIMD lanes for fewer decoding failures. The LLR
+ * gain emulates a demapper whose LLRs are large enough to saturate the 8-bit decoder
+ * messages. See bench_stream().
+ *
+ * @param state Benchmark state.
+ * @param isa LDPC decoder implementation.
+ * @param int16 Whether to use the 16-bit decoder instead of the 8-bit one.
+ * @param code LDPC code.
+ * @param esn0_db Es/N0 in dB.
+ * @param gain LLR gain.
+ */
+static void BM_ldpc_precision(benchmark::State& state,
+                              const ldpc_isa_t& isa,
+                              bool int16,
+                              std::shared_ptr<LDPCInterface> code,
+                              double esn0_db,
+                              double gain)
+{
+    const ldpc_stream_api_t& api = int16 ? isa.int16 : isa.layered;
+    bench_stream(state, isa, api, ldpc_min_sum_t(), code, esn0_db, gain);
+}
+
+/**
+ * @brief Benchmark the check node update rules with the layered schedule.
+ *
+ * See bench_stream().
+ *
+ * @param state Benchmark state.
+ * @param isa LDPC decoder implementation.
+ * @param min_sum Check node update rule.
+ * @param code LDPC code.
+ * @param esn0_db Es/N0 in dB.
+ */
+static void BM_ldpc_algorithm(benchmark::State& state,
+                              const ldpc_isa_t& isa,
+                              ldpc_min_sum_t min_sum,
+                              std::shared_ptr<LDPCInterface> code,
+                              double esn0_db)
+{
+    bench_stream(state, isa, isa.layered, min_sum, code, esn0_db);
+}
+
+/**
+ * @brief Benchmark the decoding throughput of a code at a given Eb/N0.
+ *
+ * Uses the layered schedule and the default check node update rule. The Eb/N0 is
+ * converted to the Es/N0 of the BPSK-modulated codewords based on the code rate, so the
+ * codes are compared at the same energy per information bit. See bench_stream().
+ *
+ * @param state Benchmark state.
+ * @param isa LDPC decoder implementation.
+ * @param code LDPC code.
+ * @param ebn0_db Eb/N0 in dB.
+ */
+static void BM_ldpc_throughput(benchmark::State& state,
+                               const ldpc_isa_t& isa,
+                               std::shared_ptr<LDPCInterface> code,
+                               double ebn0_db)
+{
+    const double rate = (double)code->data_len() / code->code_len();
+    const double esn0_db = ebn0_db + 10 * std::log10(rate);
+    bench_stream(state, isa, isa.layered, ldpc_min_sum_t(), code, esn0_db);
+}
+
+/**
+ * @brief Reference bit-packing of hard decisions, one LLR at a time.
+ */
+static void pack_scalar(const int8_t* llr, uint8_t* out, int bytes)
+{
+    for (int j = 0; j < bytes; j++) {
+        out[j] = 0;
+        for (int k = 0; k < 8; k++) {
+            if (llr[(j * 8) + k] < 0)
+                out[j] |= 1 << (7 - k);
+        }
+    }
+}
+
+/**
+ * @brief Benchmark the bit-packing of the hard decisions on a batch of decoded frames.
+ *
+ * Packs the decoded LLRs of a SIMD batch of normal FECFRAMEs into bytes with the MSB
+ * first, as the decoder block does on its output. The "frames/s" counter is normalized
+ * by the batch size.
+ *
+ * @param state Benchmark state.
+ * @param simd_size Number of frames per batch.
+ * @param pack Bit-packing function under test.
+ */
+static void BM_ldpc_pack(benchmark::State& state,
+                         int simd_size,
+                         void (*pack)(const int8_t*, uint8_t*, int))
+{
+    const int n = 64800; // normal FECFRAME length
+    std::vector<int8_t> llr(simd_size * n);
+    std::vector<uint8_t> out(llr.size() / 8);
+    gen_llrs(llr, 0);
+
+    for (auto _ : state) {
+        for (int i = 0; i < simd_size; i++)
+            pack(llr.data() + i * n, out.data() + i * n / 8, n / 8);
+        benchmark::DoNotOptimize(out.data());
+        benchmark::ClobberMemory();
+    }
+
+    state.counters["frames/s"] = benchmark::Counter(
+        state.iterations() * simd_size, benchmark::Counter::kIsRate);
+    state.SetBytesProcessed(state.iterations() * llr.size());
+}
+
+struct ldpc_bench_code_t {
+    const char* name;
+    std::shared_ptr<LDPCInterface> code;
+    std::vector<double> esn0_db;
+};
+
+int main(int argc, char** argv)
+{
+    std::vector<ldpc_isa_t> isas = { isa_generic };
+#ifdef CPU_FEATURES_ARCH_X86
+    isas.push_back(isa_sse41);
+    isas.push_back(isa_avx2);
+    isas.push_back(isa_avx512);
+#endif
+#ifdef CPU_FEATURES_ARCH_ANY_ARM
+    isas.push_back(isa_neon);
+#endif
+
+    // Normal FECFRAME rates 1/2 and 9/10 and short FECFRAME rate 1/2. The rate-1/2 codes
+    // are evaluated near the convergence threshold and at a higher Es/N0, where the
+    // decoder converges within a few iterations.
+    const std::vector<ldpc_bench_code_t> codes = {
+        { "normal_1/2", std::make_shared<LDPC<DVB_S2_TABLE_B4>>(), { 0, 3 } },
+        { "normal_9/10", std::make_shared<LDPC<DVB_S2_TABLE_B11>>(), { 10 } },
+        { "short_1/2", std::make_shared<LDPC<DVB_S2_TABLE_C4>>(), { 0, 3 } },
+    };
+
+    // All DVB-S2 codes for the schedule comparison, each about 0.5 dB above the Es/N0
+    // where the layered decoder starts converging within the maximum trials.
+    const std::vector<ldpc_bench_code_t> schedule_codes = {
+        { "normal_1/4", std::make_shared<LDPC<DVB_S2_TABLE_B1>>(), { -2 } },
+        { "normal_1/3", std::make_shared<LDPC<DVB_S2_TABLE_B2>>(), { -1.5 } },
+        { "normal_2/5", std::make_shared<LDPC<DVB_S2_TABLE_B3>>(), { -1 } },
+        { "normal_1/2", std::make_shared<LDPC<DVB_S2_TABLE_B4>>(), { -0.5 } },
+        { "normal_3/5", std::make_shared<LDPC<DVB_S2_TABLE_B5>>(), { 0.5 } },
+        { "normal_2/3", std::make_shared<LDPC<DVB_S2_TABLE_B6>>(), { 2 } },
+        { "normal_3/4", std::make_shared<LDPC<DVB_S2_TABLE_B7>>(), { 2 } },
+        { "normal_4/5", std::make_shared<LDPC<DVB_S2_TABLE_B8>>(), { 2.5 } },
+        { "normal_5/6", std::make_shared<LDPC<DVB_S2_TABLE_B9>>(), { 3 } },
+        { "normal_8/9", std::make_shared<LDPC<DVB_S2_TABLE_B10>>(), { 4 } },
+        { "normal_9/10", std::make_shared<LDPC<DVB_S2_TABLE_B11>>(), { 4.5 } },
+        { "short_1/4", std::make_shared<LDPC<DVB_S2_TABLE_C1>>(), { -2.5 } },
+        { "short_1/3", std::make_shared<LDPC<DVB_S2_TABLE_C2>>(), { -1.5 } },
+        { "short_2/5", std::make_shared<LDPC<DVB_S2_TABLE_C3>>(), { -1 } },
+        { "short_1/2", std::make_shared<LDPC<DVB_S2_TABLE_C4>>(), { -0.5 } },
+        { "short_3/5", std::make_shared<LDPC<DVB_S2_TABLE_C5>>(), { 0.5 } },
+        { "short_2/3", std::make_shared<LDPC<DVB_S2_TABLE_C6>>(), { 1.5 } },
+        { "short_3/4", std::make_shared<LDPC<DVB_S2_TABLE_C7>>(), { 2 } },
+        { "short_4/5", std::make_shared<LDPC<DVB_S2_TABLE_C8>>(), { 2.5 } },
+        { "short_5/6", std::make_shared<LDPC<DVB_S2_TABLE_C9>>(), { 3 } },
+        { "short_8/9", std::make_shared<LDPC<DVB_S2_TABLE_C10>>(), { 4 } },
+    };
+
+    // Low-rate codes, for which the decoder block uses the 16-bit precision by default,
+    // plus the normal FECFRAME rate 1/2 for reference, at the same Es/N0 as above.
+    const std::vector<ldpc_bench_code_t> precision_codes = {
+        schedule_codes[0], schedule_codes[1], schedule_codes[2],
+        schedule_codes[11], schedule_codes[3],
+    };
+
+    // Check node update rules with the decoder block's default parameters, and the
+    // codes to compare them on, at the Es/N0 used for the schedule comparison.
+    struct {
+        const char* name;
+        ldpc_min_sum_t min_sum;
+    } algorithms[] = {
+        { "offset", { 1.0f, 1.0f, false } },
+        { "normalized", { 0.0f, 0.875f, false } },
+        { "self_corrected", { 1.0f, 1.0f, true } },
+    };
+    const std::vector<ldpc_bench_code_t> algorithm_codes = {
+        schedule_codes[0], schedule_codes[3], schedule_codes[10], schedule_codes[14],
+    };
+
+    // Every DVB-S2 and DVB-S2X code table and frame size for the throughput suite, at
+    // Eb/N0 points spanning the convergence thresholds of the lowest to highest rates
+    const std::vector<ldpc_bench_code_t> all_codes = {
+        schedule_codes[0],
+        schedule_codes[1],
+        schedule_codes[2],
+        schedule_codes[3],
+        schedule_codes[4],
+        schedule_codes[5],
+        schedule_codes[6],
+        schedule_codes[7],
+        schedule_codes[8],
+        schedule_codes[9],
+        schedule_codes[10],
+        { "normal_2/9", std::make_shared<LDPC<DVB_S2X_TABLE_B1>>(), {} },
+        { "normal_13/45", std::make_shared<LDPC<DVB_S2X_TABLE_B2>>(), {} },
+        { "normal_9/20", std::make_shared<LDPC<DVB_S2X_TABLE_B3>>(), {} },
+        { "normal_90/180", std::make_shared<LDPC<DVB_S2X_TABLE_B11>>(), {} },
+        { "normal_96/180", std::make_shared<LDPC<DVB_S2X_TABLE_B12>>(), {} },
+        { "normal_11/20", std::make_shared<LDPC<DVB_S2X_TABLE_B4>>(), {} },
+        { "normal_100/180", std::make_shared<LDPC<DVB_S2X_TABLE_B13>>(), {} },
+        { "normal_104/180", std::make_shared<LDPC<DVB_S2X_TABLE_B14>>(), {} },
+        { "normal_26/45", std::make_shared<LDPC<DVB_S2X_TABLE_B5>>(), {} },
+        { "normal_18/30", std::make_shared<LDPC<DVB_S2X_TABLE_B22>>(), {} },
+        { "normal_28/45", std::make_shared<LDPC<DVB_S2X_TABLE_B6>>(), {} },
+        { "normal_23/36", std::make_shared<LDPC<DVB_S2X_TABLE_B7>>(), {} },
+        { "normal_116/180", std::make_shared<LDPC<DVB_S2X_TABLE_B15>>(), {} },
+        { "normal_20/30", std::make_shared<LDPC<DVB_S2X_TABLE_B23>>(), {} },
+        { "normal_124/180", std::make_shared<LDPC<DVB_S2X_TABLE_B16>>(), {} },
+        { "normal_25/36", std::make_shared<LDPC<DVB_S2X_TABLE_B8>>(), {} },
+        { "normal_128/180", std::make_shared<LDPC<DVB_S2X_TABLE_B17>>(), {} },
+        { "normal_13/18", std::make_shared<LDPC<DVB_S2X_TABLE_B9>>(), {} },
+        { "normal_132/180", std::make_shared<LDPC<DVB_S2X_TABLE_B18>>(), {} },
+        { "normal_22/30", std::make_shared<LDPC<DVB_S2X_TABLE_B24>>(), {} },
+        { "normal_135/180", std::make_shared<LDPC<DVB_S2X_TABLE_B19>>(), {} },
+        { "normal_140/180", std::make_shared<LDPC<DVB_S2X_TABLE_B20>>(), {} },
+        { "normal_7/9", std::make_shared<LDPC<DVB_S2X_TABLE_B10>>(), {} },
+        { "normal_154/180", std::make_shared<LDPC<DVB_S2X_TABLE_B21>>(), {} },
+        schedule_codes[11],
+        schedule_codes[12],
+        schedule_codes[13],
+        schedule_codes[14],
+        schedule_codes[15],
+        schedule_codes[16],
+        schedule_codes[17],
+        schedule_codes[18],
+        schedule_codes[19],
+        schedule_codes[20],
+        { "short_11/45", std::make_shared<LDPC<DVB_S2X_TABLE_C1>>(), {} },
+        { "short_4/15", std::make_shared<LDPC<DVB_S2X_TABLE_C2>>(), {} },
+        { "short_14/45", std::make_shared<LDPC<DVB_S2X_TABLE_C3>>(), {} },
+        { "short_7/15", std::make_shared<LDPC<DVB_S2X_TABLE_C4>>(), {} },
+        { "short_8/15", std::make_shared<LDPC<DVB_S2X_TABLE_C5>>(), {} },
+        { "short_26/45", std::make_shared<LDPC<DVB_S2X_TABLE_C6>>(), {} },
+        { "short_32/45", std::make_shared<LDPC<DVB_S2X_TABLE_C7>>(), {} },
+        { "medium_1/5", std::make_shared<LDPC<DVB_S2X_TABLE_C8>>(), {} },
+        { "medium_11/45", std::make_shared<LDPC<DVB_S2X_TABLE_C9>>(), {} },
+        { "medium_1/3", std::make_shared<LDPC<DVB_S2X_TABLE_C10>>(), {} },
+    };
+    const double ebn0_points[] = { 2, 3, 4, 5, 6 };
+
+    for (const auto& isa : isas) {
+        if (!isa.supported())
+            continue;
+        const std::string pack_name = std::string("BM_ldpc_pack/") + isa.name;
+        benchmark::RegisterBenchmark(
+            (pack_name + "/scalar").c_str(), BM_ldpc_pack, isa.simd_size, pack_scalar);
+        benchmark::RegisterBenchmark(
+            (pack_name + "/simd").c_str(), BM_ldpc_pack, isa.simd_size, isa.pack);
+        for (const auto& code : codes) {
+            for (double esn0_db : code.esn0_db) {
+                const std::string suffix = std::string("/") + isa.name + "/" +
+                                           code.name +
+                                           "/esn0:" + std::to_string((int)esn0_db);
+                benchmark::RegisterBenchmark(("BM_ldpc_decode" + suffix).c_str(),
+                                             BM_ldpc_decode,
+                                             isa,
+                                             code.code,
+                                             esn0_db);
+                benchmark::RegisterBenchmark(("BM_ldpc_decode_stream" + suffix).c_str(),
+                                             BM_ldpc_decode_stream,
+                                             isa,
+                                             code.code,
+                                             esn0_db);
+            }
+        }
+        for (const auto& code : precision_codes) {
+            for (double gain : { 1, 4 }) {
+                for (bool int16 : { false, true }) {
+                    const std::string name = std::string("BM_ldpc_precision/") +
+                                             isa.name + (int16 ? "/int16/" : "/int8/") +
+                                             code.name +
+                                             "/gain:" + std::to_string((int)gain);
+                    benchmark::RegisterBenchmark(name.c_str(),
+                                                 BM_ldpc_precision,
+                                                 isa,
+                                                 int16,
+                                                 code.code,
+                                                 code.esn0_db[0],
+                                                 gain);
+                }
+            }
+        }
+        for (const auto& code : algorithm_codes) {
+            for (const auto& alg : algorithms) {
+                const std::string name = std::string("BM_ldpc_algorithm/") + isa.name +
+                                         "/" + alg.name + "/" + code.name;
+                benchmark::RegisterBenchmark(name.c_str(),
+                                             BM_ldpc_algorithm,
+                                             isa,
+                                             alg.min_sum,
+                                             code.code,
+                                             code.esn0_db[0]);
+            }
+        }
+        for (const auto& code : schedule_codes) {
+            for (bool flooding : { false, true }) {
+                const std::string name = std::string("BM_ldpc_schedule/") + isa.name +
+                                         (flooding ? "/flooding/" : "/layered/") +
+                                         code.name;
+                benchmark::RegisterBenchmark(name.c_str(),
+                                             BM_ldpc_schedule,
+                                             isa,
+                                             flooding,
+                                             code.code,
+                                             code.esn0_db[0]);
+            }
+        }
+        for (const auto& code : all_codes) {
+            for (double ebn0_db : ebn0_points) {
+                const std::string name = std::string("BM_ldpc_throughput/") + isa.name +
+                                         "/" + code.name +
+                                         "/ebn0:" + std::to_string((int)ebn0_db);
+                benchmark::RegisterBenchmark(
+                    name.c_str(), BM_ldpc_throughput, isa, code.code, ebn0_db);
+            }
+        }
+    }
+
+    benchmark::Initialize(&argc, argv);
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    return 0;
+}
@@ -3,7 +3,9 @@
 #include "gr_bch.h"
 #include <aff3ct.hpp>
 #include <boost/program_options.hpp>
+#include <chrono>
 #include <iostream>
+#include <random>
 #include <vector>
 
 using namespace aff3ct;
@@ -219,6 +221,62 @@ struct utils {
         terminal; // manage the output text in the terminal
 };
 
+/**
+ * @brief Benchmark the Chien search of the new gr-dvbs2rx BCH decoder.
+ *
+ * Compares the block-based root search used by bch_codec::err_loc_numbers() against
+ * the reference gf2m_poly::search_roots_in_exp_range() implementation. Both search the
+ * roots of random error-location polynomials of degree t, each corresponding to t
+ * random bit errors over the n-bit codeword.
+ *
+ * @param N Codeword length in bits.
+ * @param t Error correction capability.
+ * @param n_polys Number of error-location polynomials to search.
+ */
+void bench_chien(int N, int t, int n_polys)
+{
+    typedef uint32_t T;
+    using namespace gr::dvbs2rx;
+    galois_field<T> gf(N >= 16200 ? 0b10000000000101101 : 0b100000000101011);
+    bch_codec<T, bitset256_t> codec(&gf, t, N);
+    const uint32_t s = ((1 << gf.get_m()) - 1) - N; // code shortening
+
+    // Error-location polynomials sigma(x) = (1 + alpha^j1 x) (1 + alpha^j2 x) ...,
+    // where j1, j2, ... are the positions of the bit errors.
+    std::mt19937 gen(0);
+    std::uniform_int_distribution<> dis(0, N - 1);
+    std::vector<gf2m_poly<T>> sigma_vec;
+    for (int i = 0; i < n_polys; i++) {
+        gf2m_poly<T> sigma(&gf, std::vector<T>({ 1 }));
+        for (int j = 0; j < t; j++)
+            sigma = sigma * gf2m_poly<T>(&gf, { 1, gf.get_alpha_i(dis(gen)) });
+        sigma_vec.push_back(sigma);
+    }
+
+    size_t n_roots_ref = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (const auto& sigma : sigma_vec)
+        n_roots_ref +=
+            sigma.search_roots_in_exp_range(s + 1, N + s, sigma.degree()).size();
+    auto end = std::chrono::steady_clock::now();
+    const double us_ref = std::chrono::duration<double, std::micro>(end - start).count();
+
+    size_t n_roots_new = 0;
+    start = std::chrono::steady_clock::now();
+    for (const auto& sigma : sigma_vec)
+        n_roots_new += codec.err_loc_numbers(sigma).size();
+    end = std::chrono::steady_clock::now();
+    const double us_new = std::chrono::duration<double, std::micro>(end - start).count();
+
+    std::cout << "# Chien search over " << n_polys << " polynomials (N=" << N
+              << ", t=" << t << ")" << std::endl;
+    std::cout << "#    ** Reference   = " << us_ref / n_polys << " us/search ("
+              << n_roots_ref << " roots)" << std::endl;
+    std::cout << "#    ** Block-based = " << us_new / n_polys << " us/search ("
+              << n_roots_new << " roots)" << std::endl;
+    std::cout << "#    ** Speedup     = " << us_ref / us_new << std::endl;
+}
+
 void init_modules(const params& p, modules& m);
 void init_buffers(const params& p, buffers& b);
 void init_utils(const modules& m, utils& u);
@@ -240,6 +298,9 @@ int parse_opts(int ac, char* av[], po::variables_map& vm)
             "ebn0-min", po::value<float>()->default_value(0), "Starting Eb/N0 in dB.")(
             "ebn0-max", po::value<float>()->default_value(10), "Ending Eb/N0 in dB.")(
             "ebn0-step", po::value<float>()->default_value(1), "Eb/N0 step in dB.")(
+            "chien",
+            "Benchmark the Chien search over nframes error-location polynomials "
+            "instead of simulating the BER/FER.")(
             "enc",
             po::value<int>()->default_value(0),
             get_impl_options("Encoder").c_str())("dec",
@@ -270,6 +331,11 @@ int main(int argc, char** argv)
     if (opt_parser_res < 1)
         return opt_parser_res;
 
+    if (args.count("chien")) {
+        bench_chien(args["n"].as<int>(), args["t"].as<int>(), args["nframes"].as<int>());
+        return 0;
+    }
+
     params p(args["n"].as<int>(),
              args["k"].as<int>(),
              args["t"].as<int>(),
@@ -35,12 +35,23 @@ public:
      * constructor is in a private implementation
      * class. dvbs2rx::bch_decoder_bb::make is the public interface for
      * creating new instances.
+     *
+     * \param standard (dvb_standard_t) DVB standard.
+     * \param framesize (dvb_framesize_t) FECFRAME size.
+     * \param rate (dvb_code_rate_t) Code rate.
+     * \param outputmode (dvb_outputmode_t) Output mode.
+     * \param debug_level (int) Debugging log level (0 disables logs).
+     * \param num_threads (int) Number of decoding threads. When greater than one, the
+     * codewords available on each work call are split into contiguous chunks decoded
+     * concurrently by a pool of worker threads, each with its own decoding workspace.
+     * The output frame order is preserved regardless of the number of threads.
      */
     static sptr make(dvb_standard_t standard,
                      dvb_framesize_t framesize,
                      dvb_code_rate_t rate,
                      dvb_outputmode_t outputmode,
-                     int debug_level = 0);
+                     int debug_level = 0,
+                     int num_threads = 1);
 
     /*!
      * \brief Get count of processed FECFRAMEs.
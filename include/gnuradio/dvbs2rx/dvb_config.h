@@ -120,6 +120,23 @@ enum dvb_infomode_t {
     INFO_ON,
 };
 
+enum dvb_ldpc_schedule_t {
+    LDPC_LAYERED = 0,
+    LDPC_FLOODING,
+};
+
+enum dvb_ldpc_precision_t {
+    LDPC_PRECISION_AUTO = 0,
+    LDPC_PRECISION_INT8,
+    LDPC_PRECISION_INT16,
+};
+
+enum dvb_ldpc_algorithm_t {
+    LDPC_OFFSET_MIN_SUM = 0,
+    LDPC_NORMALIZED_MIN_SUM,
+    LDPC_SELF_CORRECTED_MIN_SUM,
+};
+
 } // namespace dvbs2rx
 } // namespace gr
 
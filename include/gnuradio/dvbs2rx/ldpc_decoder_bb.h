@@ -34,6 +34,111 @@ public:
      * To avoid accidental use of raw pointers, dvbs2rx::ldpc_decoder_bb's constructor is
      * in a private implementation class. dvbs2rx::ldpc_decoder_bb::make is the public
      * interface for creating new instances.
+     *
+     * \param standard (dvb_standard_t) DVB standard.
+     * \param framesize (dvb_framesize_t) FECFRAME size.
+     * \param rate (dvb_code_rate_t) LDPC code rate.
+     * \param constellation (dvb_constellation_t) Constellation.
+     * \param outputmode (dvb_outputmode_t) Output the full codeword or the message only.
+     * \param infomode (dvb_infomode_t) Information mode.
+     * \param max_trials (int) Maximum number of decoding iterations per frame.
+     * \param debug_level (int) Debug level.
+     * \param batch_timeout_ms (int) Maximum time in milliseconds a partially filled
+     * SIMD batch waits for more frames before being decoded. A negative value (default)
+     * selects the throughput mode, where the decoder only processes complete SIMD
+     * batches. A non-negative value selects the latency mode, where a partial batch is
+     * decoded once its oldest frame has waited for the given timeout. A zero timeout
+     * decodes the available frames immediately.
+     * \param num_threads (int) Number of decoding threads. When greater than one, the
+     * SIMD batches available on each call to the work function are decoded concurrently
+     * by a pool of worker threads, each with its own decoder instance. The output frame
+     * order is preserved regardless of the number of threads.
+     * \param acm_vcm (bool) Whether running in ACM/VCM mode. In this mode, the decoder
+     * does not rely on the framesize and rate parameters. Instead, it reads the MODCOD
+     * and FECFRAME size of each frame from the "XFECFRAME" tags placed by the PL Sync
+     * block at the start of every frame. The frames using the same LDPC code are
+     * grouped into SIMD batches and output in their original order, each with its
+     * XFECFRAME tag.
+     * \param pls_filter_lo (uint64_t) Lower 64 bits of the PLS filter bitmask, with the
+     * same meaning as in the PL Sync block. In ACM/VCM mode, the LDPC codes of all
+     * enabled PLSs are initialized upfront, and the frames of other PLSs are dropped.
+     * \param pls_filter_hi (uint64_t) Upper 64 bits of the PLS filter bitmask.
+     * \param schedule (dvb_ldpc_schedule_t) Message-passing schedule. The layered
+     * schedule (default) updates the bit nodes after processing each group of check
+     * nodes, so it typically converges in about half the iterations of the flooding
+     * schedule, which updates all check nodes and then all bit nodes on each iteration.
+     * Only the layered schedule recycles the SIMD lanes of the frames that converge.
+     * \param llr_pdu_period (int) Number of decoded streams per PDU published on the
+     * "llr_pdu" port with the decoded LLRs, which the XFECFRAME demapper uses to refine
+     * its SNR estimate. On each call, the decoder splits the complete SIMD batches
+     * available into streams of up to eight batches, which the decoding threads process
+     * concurrently. The default of 1 publishes the LLRs of every stream, and zero
+     * disables the PDUs.
+     * \param llr_pdu_frames (int) Maximum number of frames per LLR PDU, taken from the
+     * end of the stream. Each PDU holds at most one SIMD batch, which is also the
+     * default (zero).
+     * \param precision (dvb_ldpc_precision_t) Fixed-point precision of the LLRs and
+     * messages processed by the layered decoder. The 16-bit precision avoids the
+     * saturation of the 8-bit messages, which improves the convergence at low SNR, but
+     * fits half as many frames on each SIMD register. The automatic mode (default)
+     * uses 16 bits for the codes with rates up to 2/5, which operate at the lowest
+     * SNRs, and 8 bits for the others. The flooding schedule only supports 8 bits.
+     * \param algorithm (dvb_ldpc_algorithm_t) Check node update rule. The offset
+     * min-sum (default) subtracts the offset from the magnitudes of the check node
+     * messages, whereas the normalized min-sum scales them by the normalization
+     * factor. The self-corrected min-sum applies the offset and additionally erases
+     * the messages whose sign flips between iterations.
+     * \param offset (float) Offset of the offset and self-corrected min-sum rules, in
+     * units of the input LLRs. Must be non-negative.
+     * \param factor (float) Normalization factor of the normalized min-sum rule, in
+     * the (0, 1] interval. It is rounded to a multiple of 1/8.
+     * \param min_trials (int) Minimum iteration cap of the adaptive iteration control.
+     * When positive and lower than the maximum number of iterations, the decoder
+     * lowers its iteration cap toward this minimum while the input frames pile up
+     * faster than it can decode them, and raises the cap back to the maximum once it
+     * catches up. Zero (default) disables the adaptive control.
+     * \param trials_backlog (int) Input backlog from which the adaptive control lowers
+     * the iteration cap, in frames. The backlog is measured at the start of each call
+     * to the work function and comprises the complete SIMD batches available beyond one
+     * batch per decoding thread. Zero (default) selects one SIMD batch.
+     * \param frame_stats (bool) Whether to report the decoding statistics of every
+     * frame. When enabled, each decoded frame gets an "ldpc_stats" tag on its first
+     * output byte, and the same PMT dictionary is published on the "stats" port. The
+     * dictionary holds the frame count ("frame"), the decoding iterations
+     * ("iterations"), whether the decoder converged to a valid codeword
+     * ("converged"), the number of parity checks left unsatisfied by the hard
+     * decisions ("unsatisfied_checks"), the number of frames decoded together with
+     * the frame ("batch_frames"), and the time taken to decode them in microseconds
+     * ("batch_time_us").
+     *
+     * \note The LLR PDUs reuse a small pool of preallocated vectors. When every vector
+     * is still referenced by a message in flight, e.g., because the demapper lags
+     * behind, the batch is decoded without publishing its LLRs.
+     *
+     * \note In latency mode, the timeout is checked whenever the block is scheduled,
+     * namely when new input frames or output space become available. Additionally, an
+     * internal timer wakes up the block once the oldest frame of a partial batch times
+     * out, so the batch is flushed even if no new frames arrive. The actual wait can
+     * still exceed the timeout by the scheduling delay of the block's thread.
+     *
+     * \note In ACM/VCM mode, the decoded LLRs are not published on the LLR PDU port,
+     * since a batch may group non-consecutive frames. Also, a partial batch holding the
+     * oldest pending frame is decoded without waiting for the batch timeout once the
+     * number of pending frames reaches the SIMD size times the number of distinct codes
+     * received so far.
+     *
+     * \note The adaptive control halves the distance between the iteration cap and its
+     * minimum whenever the backlog reaches the threshold, and raises the cap by one
+     * iteration whenever the backlog falls below half the threshold. The "cmd" message
+     * port accepts a PMT dictionary with the "max_trials", "min_trials", and
+     * "trials_backlog" keys to change the corresponding parameters at runtime.
+     *
+     * \note The frames decoded together share the batch decoding time. With multiple
+     * decoding threads, the batches decode concurrently, so their times overlap. The
+     * unsatisfied checks are only counted for the frames that fail to converge, the
+     * others satisfying all checks by definition. A frame that fails to converge can
+     * still report zero unsatisfied checks if some of its LLRs are zero, since the
+     * decoder only accepts nonzero LLRs, whereas the hard decisions take them as zeros.
      */
     static sptr make(dvb_standard_t standard,
                      dvb_framesize_t framesize,
@@ -42,13 +147,34 @@ public:
                      dvb_outputmode_t outputmode,
                      dvb_infomode_t infomode,
                      int max_trials,
-                     int debug_level = 0);
+                     int debug_level = 0,
+                     int batch_timeout_ms = -1,
+                     int num_threads = 1,
+                     bool acm_vcm = false,
+                     uint64_t pls_filter_lo = 0xFFFFFFFFFFFFFFFF,
+                     uint64_t pls_filter_hi = 0xFFFFFFFFFFFFFFFF,
+                     dvb_ldpc_schedule_t schedule = LDPC_LAYERED,
+                     int llr_pdu_period = 1,
+                     int llr_pdu_frames = 0,
+                     dvb_ldpc_precision_t precision = LDPC_PRECISION_AUTO,
+                     dvb_ldpc_algorithm_t algorithm = LDPC_OFFSET_MIN_SUM,
+                     float offset = 1.0,
+                     float factor = 0.875,
+                     int min_trials = 0,
+                     int trials_backlog = 0,
+                     bool frame_stats = false);
 
     /*!
      * \brief Get the average number of LDPC decoding iterations per frame.
      * \return unsigned int Average decoding interations.
      */
     virtual unsigned int get_average_trials() = 0;
+
+    /*!
+     * \brief Get the current cap on the LDPC decoding iterations per frame.
+     * \return int Maximum decoding iterations, as lowered by the adaptive control.
+     */
+    virtual int get_trials_cap() = 0;
 };
 
 } // namespace dvbs2rx
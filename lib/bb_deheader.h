@@ -0,0 +1,112 @@
+/* -*- c++ -*- */
+/*
+ * Copyright (c) 2024 Igor Freire.
+ *
+ * This file is part of gr-dvbs2rx.
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#ifndef INCLUDED_DVBS2RX_BB_DEHEADER_H
+#define INCLUDED_DVBS2RX_BB_DEHEADER_H
+
+#include "gf_util.h"
+#include "pl_submodule.h"
+#include <gnuradio/dvbs2rx/api.h>
+
+namespace gr {
+namespace dvbs2rx {
+
+#define TS_PACKET_LENGTH 188
+
+typedef struct {
+    int ts_gs;
+    int sis_mis;
+    int ccm_acm;
+    int issyi;
+    int npd;
+    int ro;
+    int isi;
+    unsigned int upl;
+    unsigned int dfl;
+    int sync;
+    unsigned int syncd;
+} BBHeader;
+
+/**
+ * \brief BB Deheader
+ *
+ * Parses the BBHEADER of descrambled BBFRAMEs and extracts the MPEG transport stream
+ * (TS) packets carried on their DATAFIELDs, including the packets that span across
+ * consecutive BBFRAMEs. The CRC-8 of each TS packet is checked, and the corrupt
+ * packets are flagged through the transport error indicator.
+ */
+class DVBS2RX_API bb_deheader : public pl_submodule
+{
+private:
+    unsigned int d_max_dfl;          /**< Maximum DATAFIELD length in bits */
+    bool d_synched;                  /**< Synchronized to the start of TS packets */
+    unsigned int d_partial_ts_bytes; /**< Byte count of the partial TS packet
+                                        extracted at the end of the previous BBFRAME */
+    unsigned char d_partial_pkt[TS_PACKET_LENGTH]; /**< Partial TS packet storage */
+    BBHeader d_bbheader;                           /**< Parsed BBHEADER */
+    uint64_t d_packet_cnt;         /**< All-time count of received packets  */
+    uint64_t d_error_cnt;          /**< All-time count of packets with bit errors */
+    uint64_t d_bbframe_cnt;        /**< All-time count of processed BBFRAMEs */
+    uint64_t d_bbframe_drop_cnt;   /**< All-time count of dropped BBFRAMEs */
+    gf2_poly<uint16_t> d_crc_poly; /**< CRC-8 generator polynomial */
+    std::vector<uint64_t> d_crc8_table; /**< CRC-8 slice-by-8 remainder look-up table */
+
+    /**
+     * @brief Parse and validate an incoming BBHEADER
+     *
+     * @param in Input bytes carrying the BBHEADER.
+     * @param h Output parsed BBHEADER.
+     * @return true When the BBHEADER is valid.
+     * @return false When the BBHEADER is invalid.
+     */
+    bool parse_bbheader(u8_cptr_t in, BBHeader* h);
+
+    /**
+     * @brief Check the CRC-8 of a sequence of bytes
+     *
+     * @param in Input bytes to check.
+     * @param size Number of bytes to check.
+     * @return true When the CRC-8 is valid.
+     * @return false When the CRC-8 is invalid.
+     */
+    bool check_crc8(u8_cptr_t in, int size);
+
+public:
+    /**
+     * @brief Construct a new BB deheader.
+     *
+     * @param kbch BBFRAME length in bits.
+     * @param debug_level Debugging log level (0 disables logs).
+     */
+    bb_deheader(unsigned int kbch, int debug_level);
+
+    /**
+     * @brief Extract the TS packets from a BBFRAME.
+     *
+     * @param in Descrambled BBFRAME with kbch/8 bytes.
+     * @param out Output buffer for the extracted TS packets.
+     * @param n_errors Incremented by the number of TS packets with CRC-8 errors.
+     * @return unsigned int Number of bytes written to the output buffer, always a
+     * multiple of the TS packet length.
+     * @note The TS packets completed within a BBFRAME span up to the DATAFIELD length
+     * plus the partial packet left over by the preceding BBFRAME.
+     */
+    unsigned int deheader(u8_cptr_t in, u8_ptr_t out, unsigned int& n_errors);
+
+    unsigned int get_max_dfl() const { return d_max_dfl; }
+    uint64_t get_packet_count() const { return d_packet_cnt; }
+    uint64_t get_error_count() const { return d_error_cnt; }
+    uint64_t get_bbframe_count() const { return d_bbframe_cnt; }
+    uint64_t get_bbframe_drop_count() const { return d_bbframe_drop_cnt; }
+};
+
+} // namespace dvbs2rx
+} // namespace gr
+
+#endif /* INCLUDED_DVBS2RX_BB_DEHEADER_H */
@@ -0,0 +1,93 @@
+/* -*- c++ -*- */
+/*
+ * Copyright (c) 2024 Igor Freire.
+ *
+ * This file is part of gr-dvbs2rx.
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#include "bb_descrambler.h"
+#include <cstdint>
+#include <cstring>
+
+#if defined(__AVX2__) || defined(__SSE2__)
+#include <immintrin.h>
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+namespace gr {
+namespace dvbs2rx {
+
+bb_descrambler::bb_descrambler(unsigned int kbch_bytes)
+    : d_kbch_bytes(kbch_bytes), d_derandomise(kbch_bytes, 0)
+{
+    compute_descrambling_sequence();
+}
+
+void bb_descrambler::compute_descrambling_sequence()
+{
+    // PRBS generator 1 + x^14 + x^15 initialized with "100101010000000"
+    int sr = 0x4A80;
+    for (unsigned int i = 0; i < d_kbch_bytes * 8; i++) {
+        int b = ((sr) ^ (sr >> 1)) & 1;
+        int i_byte = i / 8;
+        int i_bit = 7 - (i % 8);
+        d_derandomise[i_byte] |= b << i_bit;
+        sr >>= 1;
+        if (b) {
+            sr |= 0x4000;
+        }
+    }
+}
+
+void bb_descrambler::descramble(const unsigned char* in, unsigned char* out) const
+{
+    const unsigned char* seq = d_derandomise.data();
+    unsigned int j = 0;
+
+    // The BBFRAMEs are rarely aligned on a buffer of consecutive BBFRAMEs, so use the
+    // unaligned loads and stores, which cost the same as the aligned ones on aligned
+    // addresses. Peeling the leading bytes to align the stores was not faster.
+#if defined(__AVX512F__)
+    for (; j + 64 <= d_kbch_bytes; j += 64) {
+        const __m512i x = _mm512_loadu_si512(in + j);
+        const __m512i s = _mm512_loadu_si512(seq + j);
+        _mm512_storeu_si512(out + j, _mm512_xor_si512(x, s));
+    }
+#endif
+#if defined(__AVX2__)
+    for (; j + 32 <= d_kbch_bytes; j += 32) {
+        const __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + j));
+        const __m256i s = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(seq + j));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + j), _mm256_xor_si256(x, s));
+    }
+#endif
+#if defined(__SSE2__)
+    for (; j + 16 <= d_kbch_bytes; j += 16) {
+        const __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + j));
+        const __m128i s = _mm_loadu_si128(reinterpret_cast<const __m128i*>(seq + j));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + j), _mm_xor_si128(x, s));
+    }
+#elif defined(__ARM_NEON)
+    for (; j + 16 <= d_kbch_bytes; j += 16) {
+        vst1q_u8(out + j, veorq_u8(vld1q_u8(in + j), vld1q_u8(seq + j)));
+    }
+#endif
+
+    // Remainder of the BBFRAME in 64-bit words and then bytes
+    for (; j + 8 <= d_kbch_bytes; j += 8) {
+        uint64_t x, s;
+        memcpy(&x, in + j, 8);
+        memcpy(&s, seq + j, 8);
+        x ^= s;
+        memcpy(out + j, &x, 8);
+    }
+    for (; j < d_kbch_bytes; j++) {
+        out[j] = in[j] ^ seq[j];
+    }
+}
+
+} // namespace dvbs2rx
+} // namespace gr
@@ -0,0 +1,74 @@
+/* -*- c++ -*- */
+/*
+ * Copyright (c) 2024 Igor Freire.
+ *
+ * This file is part of gr-dvbs2rx.
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#ifndef INCLUDED_DVBS2RX_BB_DESCRAMBLER_H
+#define INCLUDED_DVBS2RX_BB_DESCRAMBLER_H
+
+#include <gnuradio/dvbs2rx/api.h>
+#include <volk/volk_alloc.hh>
+
+namespace gr {
+namespace dvbs2rx {
+
+/**
+ * \brief BB Descrambler
+ *
+ * Undoes the baseband (BB) scrambling of Section 5.2.2 of the standard by XORing each
+ * BBFRAME with the pseudo-random binary sequence (PRBS) used on the Tx side. The PRBS is
+ * reinitialized at the start of every BBFRAME, so it is computed once in advance.
+ *
+ * The XOR runs on the widest SIMD registers enabled at build time (AVX-512, AVX2, SSE2,
+ * or NEON), followed by 64-bit words and single bytes for the remainder of the BBFRAME.
+ * The descrambling sequence is kept on aligned memory, whereas the BBFRAMEs can start
+ * at any address, as happens on a GNU Radio buffer holding consecutive BBFRAMEs with an
+ * odd number of bytes.
+ */
+class DVBS2RX_API bb_descrambler
+{
+private:
+    const unsigned int d_kbch_bytes;           /**< BBFRAME length in bytes */
+    volk::vector<unsigned char> d_derandomise; /**< Descrambling sequence */
+
+    /**
+     * \brief Pre-compute the descrambling sequence
+     */
+    void compute_descrambling_sequence();
+
+public:
+    /**
+     * \brief Construct a new BB descrambler.
+     *
+     * \param kbch_bytes (unsigned int) BBFRAME length in bytes.
+     */
+    bb_descrambler(unsigned int kbch_bytes);
+    ~bb_descrambler(){};
+
+    /**
+     * \brief Descramble a BBFRAME.
+     *
+     * \param in (const unsigned char*) Scrambled BBFRAME with kbch/8 bytes.
+     * \param out (unsigned char*) Output buffer with space for kbch/8 bytes.
+     * \note The output buffer can be the same as the input buffer, in which case the
+     * BBFRAME is descrambled in place.
+     */
+    void descramble(const unsigned char* in, unsigned char* out) const;
+
+    /**
+     * \brief Descramble a BBFRAME in place.
+     *
+     * \param bbframe (unsigned char*) Scrambled BBFRAME with kbch/8 bytes, overwritten
+     * with the descrambled BBFRAME.
+     */
+    void descramble(unsigned char* bbframe) const { descramble(bbframe, bbframe); }
+};
+
+} // namespace dvbs2rx
+} // namespace gr
+
+#endif /* INCLUDED_DVBS2RX_BB_DESCRAMBLER_H */
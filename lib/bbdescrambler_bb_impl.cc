@@ -39,7 +39,7 @@ bbdescrambler_bb_impl::bbdescrambler_bb_impl(dvb_standard_t standard,
     fec_info_t fec_info;
     get_fec_info(standard, framesize, rate, fec_info);
     kbch_bytes = fec_info.bch.k / 8;
-    init_bb_derandomiser();
+    d_descrambler = std::make_unique<bb_descrambler>(kbch_bytes);
     set_output_multiple(kbch_bytes);
 }
 
@@ -48,22 +48,6 @@ bbdescrambler_bb_impl::bbdescrambler_bb_impl(dvb_standard_t standard,
  */
 bbdescrambler_bb_impl::~bbdescrambler_bb_impl() {}
 
-void bbdescrambler_bb_impl::init_bb_derandomiser(void)
-{
-    memset(bb_derandomise, 0, sizeof(bb_derandomise));
-    int sr = 0x4A80;
-    for (int i = 0; i < FRAME_SIZE_NORMAL; i++) {
-        int b = ((sr) ^ (sr >> 1)) & 1;
-        int i_byte = i / 8;
-        int i_bit = 7 - (i % 8);
-        bb_derandomise[i_byte] |= b << i_bit;
-        sr >>= 1;
-        if (b) {
-            sr |= 0x4000;
-        }
-    }
-}
-
 int bbdescrambler_bb_impl::work(int noutput_items,
                                 gr_vector_const_void_star& input_items,
                                 gr_vector_void_star& output_items)
@@ -72,9 +56,7 @@ int bbdescrambler_bb_impl::work(int noutput_items,
     unsigned char* out = (unsigned char*)output_items[0];
 
     for (int i = 0; i < noutput_items; i += kbch_bytes) {
-        for (int j = 0; j < (int)kbch_bytes; ++j) {
-            out[i + j] = in[i + j] ^ bb_derandomise[j];
-        }
+        d_descrambler->descramble(in + i, out + i);
     }
 
     // Tell runtime system how many output items we produced.
@@ -10,8 +10,9 @@
 #ifndef INCLUDED_DVBS2RX_BBDESCRAMBLER_BB_IMPL_H
 #define INCLUDED_DVBS2RX_BBDESCRAMBLER_BB_IMPL_H
 
-#include "dvb_defines.h"
+#include "bb_descrambler.h"
 #include <gnuradio/dvbs2rx/bbdescrambler_bb.h>
+#include <memory>
 
 namespace gr {
 namespace dvbs2rx {
@@ -19,10 +20,8 @@ namespace dvbs2rx {
 class bbdescrambler_bb_impl : public bbdescrambler_bb
 {
 private:
-    unsigned int kbch;
     unsigned int kbch_bytes;
-    unsigned char bb_derandomise[FRAME_SIZE_NORMAL / 8];
-    void init_bb_derandomiser(void);
+    std::unique_ptr<bb_descrambler> d_descrambler;
 
 public:
     bbdescrambler_bb_impl(dvb_standard_t standard,
@@ -0,0 +1,162 @@
+/* -*- c++ -*- */
+/*
+ * Copyright (c) 2024 Igor Freire.
+ *
+ * This file is part of gr-dvbs2rx.
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include "bbframe_processor_bb_impl.h"
+#include "debug_level.h"
+#include "dvb_defines.h"
+#include "fec_params.h"
+#include <gnuradio/io_signature.h>
+#include <gnuradio/logger.h>
+#include <algorithm>
+#include <cmath>
+
+namespace gr {
+namespace dvbs2rx {
+
+bbframe_processor_bb::sptr bbframe_processor_bb::make(dvb_standard_t standard,
+                                                      dvb_framesize_t framesize,
+                                                      dvb_code_rate_t rate,
+                                                      int debug_level)
+{
+    return gnuradio::get_initial_sptr(
+        new bbframe_processor_bb_impl(standard, framesize, rate, debug_level));
+}
+
+/*
+ * The private constructor
+ */
+bbframe_processor_bb_impl::bbframe_processor_bb_impl(dvb_standard_t standard,
+                                                     dvb_framesize_t framesize,
+                                                     dvb_code_rate_t rate,
+                                                     int debug_level)
+    : gr::block("bbframe_processor_bb",
+                gr::io_signature::make(1, 1, sizeof(unsigned char)),
+                gr::io_signature::make(1, 1, sizeof(unsigned char))),
+      d_debug_level(debug_level),
+      d_frame_cnt(0),
+      d_frame_error_cnt(0)
+{
+    fec_info_t fec_info;
+    get_fec_info(standard, framesize, rate, fec_info);
+    d_k_bytes = fec_info.bch.k / 8;
+    d_n_bytes = fec_info.bch.n / 8;
+    d_max_dfl = fec_info.bch.k - BB_HEADER_LENGTH_BITS;
+
+    // BCH codec, as in the BCH decoder block
+    uint32_t prim_poly;
+    if (framesize == FECFRAME_NORMAL)
+        prim_poly = 0b10000000000101101; // x^16 + x^5 + x^3 + x^2 + 1
+    else if (framesize == FECFRAME_SHORT)
+        prim_poly = 0b100000000101011; // x^14 + x^5 + x^3 + x + 1
+    else
+        prim_poly = 0b1000000000101101; // x^15 + x^5 + x^3 + x^2 + 1
+    d_gf = std::make_unique<galois_field<uint32_t>>(prim_poly);
+    d_codec = std::make_unique<bch_codec<uint32_t, bitset256_t>>(
+        d_gf.get(), fec_info.bch.t, fec_info.bch.n);
+
+    d_descrambler = std::make_unique<bb_descrambler>(d_k_bytes);
+    d_deheader = std::make_unique<bb_deheader>(fec_info.bch.k, debug_level);
+    d_bbframe.resize(d_k_bytes);
+    set_output_multiple(d_max_dfl / 8); // ensure full BBFRAMEs on the input
+}
+
+/*
+ * Our virtual destructor.
+ */
+bbframe_processor_bb_impl::~bbframe_processor_bb_impl() {}
+
+void bbframe_processor_bb_impl::forecast(int noutput_items,
+                                         gr_vector_int& ninput_items_required)
+{
+    unsigned int n_bbframes =
+        std::ceil(static_cast<double>(noutput_items * 8) / d_max_dfl);
+    ninput_items_required[0] = n_bbframes * d_n_bytes;
+}
+
+int bbframe_processor_bb_impl::general_work(int noutput_items,
+                                            gr_vector_int& ninput_items,
+                                            gr_vector_const_void_star& input_items,
+                                            gr_vector_void_star& output_items)
+{
+    const unsigned char* in = (const unsigned char*)input_items[0];
+    unsigned char* out = (unsigned char*)output_items[0];
+    unsigned int produced = 0;
+    unsigned int errors = 0;
+
+    // Process as many FECFRAMEs as possible, as long as these are available on the input
+    // buffer and their TS packets fit on the output buffer
+    const unsigned int in_frames = ninput_items[0] / d_n_bytes;
+    const unsigned int out_frames =
+        std::ceil(static_cast<double>(noutput_items * 8) / d_max_dfl);
+    const unsigned int n_frames = std::min(in_frames, out_frames);
+
+    // BCH decoding of the whole batch at once, so that the remainder computation can
+    // process several codewords per pass. The error-free BBFRAMEs are read directly from
+    // the input buffer, and the corrected ones from copies placed back to back on the BCH
+    // workspace, in the order of the frames.
+    if (d_decoded_msgs.size() < n_frames) {
+        d_decoded_msgs.resize(n_frames);
+        d_corrections.resize(n_frames);
+    }
+    d_codec->decode_zero_copy(
+        in, n_frames, d_decoded_msgs.data(), d_corrections.data(), d_workspace);
+
+    u8_ptr_t corrected_msg = d_workspace.corrected_msgs.data();
+    for (unsigned int i = 0; i < n_frames; i++) {
+        const int corrections = d_corrections[i];
+        if (corrections > 0) {
+            GR_LOG_DEBUG_LEVEL(1,
+                               "frame = {:d}, BCH decoder corrections = {:d}",
+                               d_frame_cnt,
+                               corrections);
+        } else if (corrections == -1) {
+            d_frame_error_cnt++;
+            GR_LOG_DEBUG_LEVEL(
+                1,
+                "frame = {:d}, BCH decoder too many bit errors (FER = {:g})",
+                d_frame_cnt,
+                ((double)d_frame_error_cnt / (d_frame_cnt + 1)));
+        }
+        d_frame_cnt++;
+
+        // Descrambling and TS packet extraction. The BBFRAMEs with errors were copied
+        // into the BCH workspace, so descramble them in place. The error-free ones are
+        // still on the read-only input buffer.
+        u8_ptr_t descrambled;
+        if (corrections != 0) {
+            descrambled = corrected_msg;
+            corrected_msg += d_k_bytes;
+            d_descrambler->descramble(descrambled);
+        } else {
+            descrambled = d_bbframe.data();
+            d_descrambler->descramble(d_decoded_msgs[i], descrambled);
+        }
+        const unsigned int n_bytes = d_deheader->deheader(descrambled, out, errors);
+        out += n_bytes;
+        produced += n_bytes;
+    }
+
+    if (errors != 0) {
+        GR_LOG_DEBUG_LEVEL(1,
+                           "TS packet crc errors = {:d} (PER = {:g})",
+                           errors,
+                           ((double)d_deheader->get_error_count() /
+                            d_deheader->get_packet_count()));
+    }
+
+    consume_each(n_frames * d_n_bytes);
+    return produced;
+}
+
+} /* namespace dvbs2rx */
+} /* namespace gr */
@@ -0,0 +1,66 @@
+/* -*- c++ -*- */
+/*
+ * Copyright (c) 2024 Igor Freire.
+ *
+ * This file is part of gr-dvbs2rx.
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#ifndef INCLUDED_DVBS2RX_BBFRAME_PROCESSOR_BB_IMPL_H
+#define INCLUDED_DVBS2RX_BBFRAME_PROCESSOR_BB_IMPL_H
+
+#include "bb_deheader.h"
+#include "bb_descrambler.h"
+#include "bch.h"
+#include <gnuradio/dvbs2rx/bbframe_processor_bb.h>
+#include <memory>
+#include <vector>
+
+namespace gr {
+namespace dvbs2rx {
+
+class bbframe_processor_bb_impl : public bbframe_processor_bb
+{
+private:
+    const int d_debug_level;
+    unsigned int d_k_bytes;     // BBFRAME (BCH message) length in bytes
+    unsigned int d_n_bytes;     // BCH codeword length in bytes
+    unsigned int d_max_dfl;     // maximum DATAFIELD length in bits
+    uint64_t d_frame_cnt;       // all-time count of decoded FECFRAMEs
+    uint64_t d_frame_error_cnt; // all-time count of FECFRAMEs with residual errors
+    std::unique_ptr<galois_field<uint32_t>> d_gf;
+    std::unique_ptr<bch_codec<uint32_t, bitset256_t>> d_codec;
+    bch_workspace_t<uint32_t, bitset256_t> d_workspace; // BCH decoding scratch memory
+    std::unique_ptr<bb_descrambler> d_descrambler;
+    std::unique_ptr<bb_deheader> d_deheader; // BBHEADER parser and TS packet extractor
+    u8_vector_t d_bbframe;                   // descrambled BBFRAME
+    std::vector<u8_cptr_t> d_decoded_msgs;   // BCH-decoded BBFRAMEs of the current batch
+    std::vector<int> d_corrections;          // BCH corrections of the current batch
+
+public:
+    bbframe_processor_bb_impl(dvb_standard_t standard,
+                              dvb_framesize_t framesize,
+                              dvb_code_rate_t rate,
+                              int debug_level);
+    ~bbframe_processor_bb_impl();
+
+    void forecast(int noutput_items, gr_vector_int& ninput_items_required);
+
+    int general_work(int noutput_items,
+                     gr_vector_int& ninput_items,
+                     gr_vector_const_void_star& input_items,
+                     gr_vector_void_star& output_items);
+
+    uint64_t get_frame_count() { return d_frame_cnt; }
+    uint64_t get_frame_error_count() { return d_frame_error_cnt; }
+    uint64_t get_packet_count() { return d_deheader->get_packet_count(); }
+    uint64_t get_packet_error_count() { return d_deheader->get_error_count(); }
+    uint64_t get_bbframe_count() { return d_deheader->get_bbframe_count(); }
+    uint64_t get_bbframe_drop_count() { return d_deheader->get_bbframe_drop_count(); }
+};
+
+} // namespace dvbs2rx
+} // namespace gr
+
+#endif /* INCLUDED_DVBS2RX_BBFRAME_PROCESSOR_BB_IMPL_H */
@@ -12,6 +12,7 @@
 #include <cstring>
 #include <map>
 #include <stdexcept>
+#include <type_traits>
 
 namespace gr {
 namespace dvbs2rx {
@@ -74,7 +75,9 @@ bch_codec<T, P>::bch_codec(const galois_field<T>* const gf, uint8_t t, uint32_t
       m_k_bytes(m_k / 8),
       m_parity_bytes(m_n_bytes - m_k_bytes),
       m_msg_mask(bitmask<T>(m_k)), // k-bit mask
-      m_gen_poly_lut_generated(false)
+      m_gen_poly_lut_generated(false),
+      m_gen_poly_rem_clmul(false),
+      m_chien_avx2(false)
 {
     if (n > ((static_cast<uint32_t>(1) << gf->get_m()) - 1))
         throw std::runtime_error("Codeword length n exceeds the maximum of (2^m - 1)");
@@ -88,18 +91,26 @@ bch_codec<T, P>::bch_codec(const galois_field<T>* const gf, uint8_t t, uint32_t
 
     // When k and n are multiples of 8, the message and parity bits are byte-aligned, so
     // encoding and decoding into/from a bytes array becomes supported. For that, generate
-    // a LUT to help in computing the remainder of "r(x) % g(x)", where r(x) is an
+    // LUTs to help in computing the remainder of "r(x) % g(x)", where r(x) is an
     // arbitrary GF(2) polynomial and g(x) is the generator polynomial. On encoding, r(x)
     // is the padded message polynomial, and on decoding, r(x) is the received codeword.
     //
-    // NOTE: This LUT imposes an additional limitation on the maximum degree of g(x) based
-    // on the size of type P. Since g(x) can have degree up to m*t, the P-typed remainder
-    // LUT can only be computed for a g(x) with degree up to (sizeof(P) - 1)*8, as
-    // detailed in the implementation of the LUT builder. Hence, to alleviate the issue,
-    // compute the LUT only when bytes-based encoding is supported.
+    // NOTE: These LUTs impose an additional limitation on the maximum degree of g(x)
+    // based on the size of type P. Since g(x) can have degree up to m*t, the remainder
+    // LUTs can only be computed for a g(x) with degree up to (sizeof(P) - 1)*8, as
+    // detailed in the implementation of the LUT builders. Hence, to alleviate the issue,
+    // compute the LUTs only when bytes-based encoding is supported.
     if (m_k % 8 == 0 || m_n % 8 == 0) {
-        m_gen_poly_rem_lut = build_gf2_poly_rem_lut(m_g);
+        m_gen_poly_rem_word_lut = build_gf2_poly_rem_word_lut(m_g);
+        m_gen_poly_rem_slice_lut = build_gf2_poly_rem_slice_lut(m_g, 8);
         m_gen_poly_lut_generated = true;
+        // Prefer the folding by carry-less multiplication when the CPU supports it,
+        // which covers the generator polynomials of all DVB-S2 BCH codes (degree up to
+        // 192). See gen_poly_rem().
+        if (m_g.degree() <= 192 && gf2_clmul_supported()) {
+            m_gen_poly_rem_clmul_consts = build_gf2_poly_rem_clmul_consts(m_g);
+            m_gen_poly_rem_clmul = true;
+        }
     }
 
     // Generate a LUT to solve quadratic error-location polynomials faster than with
@@ -110,6 +121,17 @@ bch_codec<T, P>::bch_codec(const galois_field<T>* const gf, uint8_t t, uint32_t
         T idx = m_gf->multiply(r, r) ^ r; // R*(R+1)
         m_quadratic_poly_lut[idx] = r;
     }
+
+    // Antilog table mapping each exponent i to alpha^i, extended beyond (2^m - 2) so that
+    // the Chien search can look up a whole block of exponents without modulo reduction.
+    // The extra zero element pads the 32-bit gathers of the AVX2 search over a 16-bit
+    // table. See chien_search() for details.
+    const uint32_t antilog_len = (two_to_m - 1) + (chien_block_len - 1) * m_t;
+    m_chien_antilog.resize(antilog_len + 1);
+    for (uint32_t i = 0; i < antilog_len; i++)
+        m_chien_antilog[i] = m_gf->get_alpha_i(i);
+    if constexpr (std::is_same_v<T, uint16_t> || std::is_same_v<T, uint32_t>)
+        m_chien_avx2 = gf_chien_avx2_supported();
 }
 
 
@@ -167,7 +189,7 @@ void bch_codec<T, P>::encode(u8_cptr_t msg, u8_ptr_t codeword) const
     memcpy(codeword, msg, m_k_bytes); // systematic bytes
     memset(codeword + m_k_bytes, 0,
            m_parity_bytes); // zero-initialize the parity bytes
-    const auto parity_poly = gf2_poly_rem(codeword, m_n_bytes, m_g, m_gen_poly_rem_lut);
+    const auto parity_poly = gen_poly_rem(codeword);
     const auto parity_poly_u8_vec = to_u8_vector(parity_poly.get_poly(), m_parity_bytes);
     memcpy(codeword + m_k_bytes, parity_poly_u8_vec.data(), m_parity_bytes);
 }
@@ -213,14 +235,56 @@ std::vector<T> bch_codec<T, P>::syndrome(const T& codeword) const
     return _eval_syndrome(parity_poly, m_gf, m_t);
 }
 
+template <typename T, typename P>
+gf2_poly<P> bch_codec<T, P>::gen_poly_rem(u8_cptr_t codeword) const
+{
+    if (m_gen_poly_rem_clmul)
+        return gf2_poly_rem_clmul(codeword,
+                                  m_n_bytes,
+                                  m_g,
+                                  m_gen_poly_rem_clmul_consts,
+                                  m_gen_poly_rem_word_lut);
+    return gf2_poly_rem_slice(codeword, m_n_bytes, m_g, m_gen_poly_rem_slice_lut);
+}
+
+template <typename T, typename P>
+void bch_codec<T, P>::gen_poly_rem(u8_cptr_t codewords,
+                                   uint32_t n_codewords,
+                                   gf2_poly<P>* rem) const
+{
+    // The folding is considerably faster than the LUT-based computation even when the
+    // latter processes several codewords in lockstep, so it runs one codeword at a time.
+    if (m_gen_poly_rem_clmul) {
+        for (uint32_t i = 0; i < n_codewords; i++)
+            rem[i] = gen_poly_rem(codewords + i * m_n_bytes);
+        return;
+    }
+    gf2_poly_rem_batch(
+        codewords, m_n_bytes, n_codewords, m_g, m_gen_poly_rem_word_lut, rem);
+}
+
 template <typename T, typename P>
 std::vector<T> bch_codec<T, P>::syndrome(u8_cptr_t codeword) const
 {
     assert_byte_aligned_n_k(m_n, m_k);
-    const auto parity_poly = gf2_poly_rem(codeword, m_n_bytes, m_g, m_gen_poly_rem_lut);
+    const auto parity_poly = gen_poly_rem(codeword);
     return _eval_syndrome(parity_poly, m_gf, m_t);
 }
 
+template <typename T, typename P>
+std::vector<std::vector<T>> bch_codec<T, P>::syndrome(u8_cptr_t codewords,
+                                                      uint32_t n_codewords) const
+{
+    assert_byte_aligned_n_k(m_n, m_k);
+    std::vector<gf2_poly<P>> parity_polys(n_codewords, gf2_poly<P>(0));
+    gen_poly_rem(codewords, n_codewords, parity_polys.data());
+    std::vector<std::vector<T>> syndromes;
+    syndromes.reserve(n_codewords);
+    for (const auto& parity_poly : parity_polys)
+        syndromes.push_back(_eval_syndrome(parity_poly, m_gf, m_t));
+    return syndromes;
+}
+
 template <typename T, typename P>
 gf2m_poly<T> bch_codec<T, P>::err_loc_polynomial(const std::vector<T>& syndrome) const
 {
@@ -372,18 +436,83 @@ std::vector<T> bch_codec<T, P>::err_loc_numbers(const gf2m_poly<T>& sigma) const
     // range from alpha^(n+s) to alpha^(s+1). See if any of these are the roots of sigma
     // and record the results.
     //
-    // TODO: optimize this computation using a strategy like the one in Fig. 6.1.
-    std::vector<uint32_t> root_exps =
-        sigma.search_roots_in_exp_range(m_s + 1,       // starting exponent
-                                        m_n + m_s,     // ending exponent
-                                        sigma.degree() // max number of roots to find
-        );
-    std::vector<T> numbers(root_exps.size());
-    for (size_t i = 0; i < root_exps.size(); i++)
-        numbers[i] = m_gf->inverse_by_exp(root_exps[i]);
+    std::vector<T> numbers(sigma.degree());
+    const int n_numbers =
+        chien_search(sigma.get_poly().data(), sigma.degree(), numbers.data());
+    numbers.resize(n_numbers);
     return numbers;
 }
 
+template <typename T, typename P>
+int bch_codec<T, P>::chien_search(const T* sigma, int degree, T* numbers) const
+{
+    // Evaluate sigma(alpha^i) for i from s + 1 to n + s, as explained in
+    // gf2m_poly::search_roots_in_exp_range(). Each non-zero term sigma_j x^j evaluates
+    // to alpha^(e_j + i*j) for x = alpha^i, where e_j is the exponent of sigma_j. Hence,
+    // over a block of consecutive exponents i, the antilog table indexes of each term
+    // form an arithmetic progression with step j. Process one block of exponents at a
+    // time and, for each term, accumulate the table entries of the whole block. When the
+    // CPU supports AVX2, gather the entries of eight exponents per instruction (see
+    // gf_chien_search_block_avx2()). Otherwise, look them up one at a time. Since the
+    // antilog table is extended beyond 2^m - 2, the block lookups do not need modulo
+    // reductions. Only the block starting exponents are reduced.
+    const uint32_t two_to_m_minus_one = (static_cast<uint32_t>(1) << m_gf->get_m()) - 1;
+    const uint32_t i_start = m_s + 1;
+    const uint32_t i_end = m_n + m_s;
+
+    std::array<uint32_t, 256> exps;  // antilog index of each non-zero term
+    std::array<uint32_t, 256> steps; // order (index j) of each non-zero term
+    int n_terms = 0;
+    for (int j = 0; j <= degree; j++) {
+        if (sigma[j] != 0) {
+            exps[n_terms] = (m_gf->get_exponent(sigma[j]) +
+                             static_cast<uint64_t>(i_start) * j) %
+                            two_to_m_minus_one;
+            steps[n_terms++] = j;
+        }
+    }
+
+    int n_found = 0;
+    T block[chien_block_len];
+    for (uint32_t i = i_start; i <= i_end; i += chien_block_len) {
+        uint64_t roots = 0; // bit k set if alpha^(i + k) is a root
+        if constexpr (std::is_same_v<T, uint16_t> || std::is_same_v<T, uint32_t>) {
+            if (m_chien_avx2) {
+                roots = gf_chien_search_block_avx2(
+                    m_chien_antilog.data(), exps.data(), steps.data(), n_terms);
+            }
+        }
+        if (!m_chien_avx2) {
+            for (int k = 0; k < chien_block_len; k++)
+                block[k] = 0;
+            for (int j = 0; j < n_terms; j++) {
+                const T* antilog = m_chien_antilog.data() + exps[j];
+                const uint32_t step = steps[j];
+                for (int k = 0; k < chien_block_len; k++)
+                    block[k] ^= antilog[k * step];
+            }
+            for (int k = 0; k < chien_block_len; k++)
+                roots |= static_cast<uint64_t>(block[k] == 0) << k;
+        }
+        for (int j = 0; j < n_terms; j++)
+            exps[j] = (exps[j] + chien_block_len * steps[j]) % two_to_m_minus_one;
+
+        // Stop as soon as all roots are found, given that sigma(x) has at most as many
+        // roots as its degree.
+        const uint32_t len = std::min<uint32_t>(chien_block_len, i_end - i + 1);
+        if (len < chien_block_len)
+            roots &= (static_cast<uint64_t>(1) << len) - 1;
+        while (roots != 0) {
+            const int k = __builtin_ctzll(roots);
+            roots &= roots - 1;
+            numbers[n_found++] = m_gf->inverse_by_exp(i + k);
+            if (n_found == degree)
+                return n_found;
+        }
+    }
+    return n_found;
+}
+
 /**
  * @brief Correct errors in the given codeword.
  *
@@ -420,6 +549,7 @@ void correct_errors(T& codeword,
  * @param k Message length in bits.
  * @param gf Reference Galois field.
  * @param numbers Error location numbers.
+ * @param n_numbers Number of error location numbers.
  * @note Unlike the alternative implementation based on T-typed codewords, this
  * implementation (based on u8 arrays) corrects the k-bit message part only while ignoring
  * errors in the parity bits. The main motivation for this approach is the ability to
@@ -430,9 +560,11 @@ void correct_errors(u8_ptr_t decoded_msg,
                     uint32_t n,
                     uint32_t k,
                     const galois_field<T>* gf,
-                    const std::vector<T>& numbers)
+                    const T* numbers,
+                    size_t n_numbers)
 {
-    for (const T& number : numbers) {
+    for (size_t i = 0; i < n_numbers; i++) {
+        const T& number = numbers[i];
         // Same as above but taking the network byte order into account. When interpreting
         // the codeword as a polynomial over GF(2), the first bit in the first byte of the
         // array pointed by decoded_msg is the highest-order coefficient (multiplying
@@ -470,19 +602,223 @@ int bch_codec<T, P>::decode(u8_cptr_t codeword, u8_ptr_t decoded_msg) const
     assert_byte_aligned_n_k(m_n, m_k);
     memcpy(decoded_msg, codeword, m_k_bytes); // systematic bytes
     const auto s = syndrome(codeword);
-    if (s.size() > 0) { // an empty syndrome means no errors
-        const auto poly = err_loc_polynomial(s);
-        const auto numbers = err_loc_numbers(poly);
-        correct_errors(decoded_msg, m_n, m_k, m_gf, numbers);
-        // Generally, the error location polynomial has degree greater than t when the
-        // codeword has more than t errors, in which case the errors cannot be located.
-        // Also, even if the error location polynomial has degree <= t, not necessarily
-        // all error location numbers can be found. The err_loc_numbers function should
-        // obtain a number of error location numbers equivalent to the degree of the error
-        // location polynomial. Otherwise, not all errors can be corrected.
-        return poly.degree() == static_cast<int>(numbers.size()) ? numbers.size() : -1;
-    } else {
+    if (s.size() > 0) // an empty syndrome means no errors
+        return correct(s, decoded_msg);
+    else
         return 0;
+}
+
+template <typename T, typename P>
+int bch_codec<T, P>::correct(const std::vector<T>& syndrome, u8_ptr_t decoded_msg) const
+{
+    const auto poly = err_loc_polynomial(syndrome);
+    const auto numbers = err_loc_numbers(poly);
+    correct_errors(decoded_msg, m_n, m_k, m_gf, numbers.data(), numbers.size());
+    // Generally, the error location polynomial has degree greater than t when the
+    // codeword has more than t errors, in which case the errors cannot be located.
+    // Also, even if the error location polynomial has degree <= t, not necessarily
+    // all error location numbers can be found. The err_loc_numbers function should
+    // obtain a number of error location numbers equivalent to the degree of the error
+    // location polynomial. Otherwise, not all errors can be corrected.
+    return poly.degree() == static_cast<int>(numbers.size()) ? numbers.size() : -1;
+}
+
+template <typename T, typename P>
+void bch_codec<T, P>::eval_syndrome(const gf2_poly<P>& parity_poly,
+                                    bch_workspace_t<T, P>& ws) const
+{
+    // Same as _eval_syndrome, but evaluating the parity polynomial directly over its
+    // binary coefficients instead of converting it into a gf2m_poly object. Also, for
+    // binary BCH codes, the even syndrome components can be derived from the odd ones
+    // since S_2i = (S_i)^2. Hence, evaluate the odd components only.
+    T* syndrome = ws.syndrome.data();
+    for (int i = 0; i < 2 * m_t; i++)
+        syndrome[i] = 0;
+
+    const P& coefs = parity_poly.get_poly();
+    for (int j = 0; j <= parity_poly.degree(); j++) {
+        if (!is_bit_set(coefs, j))
+            continue;
+        // The j-th bit contributes (alpha^i)^j = alpha^(i*j) to S_i.
+        for (int i = 1; i < 2 * m_t; i += 2)
+            syndrome[i - 1] ^= m_gf->get_alpha_i(i * j);
+    }
+
+    for (int i = 2; i <= 2 * m_t; i += 2)
+        syndrome[i - 1] = m_gf->multiply(syndrome[i / 2 - 1], syndrome[i / 2 - 1]);
+}
+
+template <typename T, typename P>
+int bch_codec<T, P>::correct(bch_workspace_t<T, P>& ws, u8_ptr_t decoded_msg) const
+{
+    // Berlekamp's iterative algorithm, as in err_loc_polynomial(), but computed over the
+    // fixed-capacity table rows of the workspace. Row r holds the candidate polynomial
+    // sigma(x) for mu = r - 1, or mu = -1/2 on the first row, which is represented here
+    // through "two_mu[r] = 2 * mu".
+    const T* syndrome = ws.syndrome.data();
+    auto& sigma = ws.sigma;
+    auto& deg = ws.sigma_degree;
+    auto& d = ws.discrepancy;
+    const int max_degree = bch_workspace_t<T, P>::max_sigma_len - 1;
+    auto two_mu = [](int r) { return (r == 0) ? -1 : 2 * (r - 1); };
+
+    const T unit = m_gf->get_alpha_i(0);
+    sigma[0][0] = unit;
+    deg[0] = 0;
+    sigma[1][0] = unit;
+    deg[1] = 0;
+    sigma[2][0] = unit;
+    sigma[2][1] = syndrome[0];
+    deg[2] = (syndrome[0] != 0) ? 1 : 0;
+    d[0] = unit;
+    d[1] = syndrome[0];
+
+    int row = 2;
+    while (row <= m_t) {
+        const int two_mu_row = two_mu(row);
+        d[row] = syndrome[two_mu_row];
+        for (int j = 1; j <= std::min(deg[row], two_mu_row); j++) {
+            if (sigma[row][j] != 0)
+                d[row] ^= m_gf->multiply(sigma[row][j], syndrome[two_mu_row - j]);
+        }
+
+        auto& next = sigma[row + 1];
+        if (d[row] == 0) {
+            next = sigma[row];
+            deg[row + 1] = deg[row];
+        } else {
+            int row_rho = 0;
+            int max_diff = -2;
+            for (int j = row - 1; j >= 0; j--) {
+                if (d[j] != 0) {
+                    int diff = two_mu(j) - deg[j];
+                    if (diff > max_diff) {
+                        max_diff = diff;
+                        row_rho = j;
+                    }
+                }
+            }
+
+            // Equation (6.41): sigma_row(x) + (d_mu / d_rho) x^(2(mu - rho)) sigma_rho(x)
+            const int shift = two_mu_row - two_mu(row_rho);
+            const int new_max_degree = std::max(deg[row], shift + deg[row_rho]);
+            if (new_max_degree > max_degree)
+                return -1; // too many errors to be located anyway
+            const T d_mu_inv_d_rho = m_gf->divide(d[row], d[row_rho]);
+            for (int j = 0; j <= new_max_degree; j++)
+                next[j] = (j <= deg[row]) ? sigma[row][j] : 0;
+            for (int j = 0; j <= deg[row_rho]; j++)
+                next[j + shift] ^= m_gf->multiply(d_mu_inv_d_rho, sigma[row_rho][j]);
+            int new_degree = new_max_degree;
+            while (new_degree > 0 && next[new_degree] == 0)
+                new_degree--;
+            deg[row + 1] = new_degree;
+        }
+        row += 1;
+    }
+
+    // Error-location numbers, as in err_loc_numbers(), but stored in the workspace
+    const T* sig = sigma[row].data();
+    const int degree = deg[row];
+    T* numbers = ws.numbers.data();
+    int n_numbers = 0;
+    if (degree > m_t) {
+        return -1;
+    } else if (degree == 1) {
+        numbers[n_numbers++] = m_gf->divide(sig[1], sig[0]);
+    } else if (degree == 2) {
+        // See the quadratic solution based on a LUT in err_loc_numbers()
+        if (sig[1] == 0 || sig[0] == 0)
+            return -1;
+        T b_over_a = m_gf->divide(sig[1], sig[2]);
+        T r_sq_plus_r =
+            m_gf->divide(m_gf->multiply(sig[0], sig[2]), m_gf->multiply(sig[1], sig[1]));
+        T r = m_quadratic_poly_lut[r_sq_plus_r];
+        numbers[n_numbers++] = m_gf->inverse(m_gf->multiply(r, b_over_a));
+        numbers[n_numbers++] = m_gf->inverse(m_gf->multiply(b_over_a, (r ^ 1)));
+    } else if (degree > 2) {
+        n_numbers = chien_search(sig, degree, numbers);
+    }
+
+    correct_errors(decoded_msg, m_n, m_k, m_gf, numbers, n_numbers);
+    return (degree == n_numbers) ? n_numbers : -1;
+}
+
+template <typename T, typename P>
+int bch_codec<T, P>::decode(u8_cptr_t codeword,
+                            const gf2_poly<P>& parity_poly,
+                            u8_ptr_t decoded_msg,
+                            bch_workspace_t<T, P>& ws) const
+{
+    if (m_t > bch_workspace_t<T, P>::max_t)
+        throw std::runtime_error("Error correction capability t exceeds the workspace");
+    memcpy(decoded_msg, codeword, m_k_bytes); // systematic bytes
+    if (parity_poly.is_zero()) // a zero remainder means no errors
+        return 0;
+    eval_syndrome(parity_poly, ws);
+    return correct(ws, decoded_msg);
+}
+
+template <typename T, typename P>
+int bch_codec<T, P>::decode(u8_cptr_t codeword,
+                            u8_ptr_t decoded_msg,
+                            bch_workspace_t<T, P>& ws) const
+{
+    assert_byte_aligned_n_k(m_n, m_k);
+    const auto parity_poly = gen_poly_rem(codeword);
+    return decode(codeword, parity_poly, decoded_msg, ws);
+}
+
+template <typename T, typename P>
+void bch_codec<T, P>::decode(u8_cptr_t codewords,
+                             u8_ptr_t decoded_msgs,
+                             uint32_t n_codewords,
+                             int* corrections,
+                             bch_workspace_t<T, P>& ws) const
+{
+    assert_byte_aligned_n_k(m_n, m_k);
+    if (ws.parity.size() < n_codewords) // grows up to the largest batch only
+        ws.parity.resize(n_codewords, gf2_poly<P>(0));
+    gen_poly_rem(codewords, n_codewords, ws.parity.data());
+    for (uint32_t i = 0; i < n_codewords; i++) {
+        corrections[i] = decode(codewords + i * m_n_bytes,
+                                ws.parity[i],
+                                decoded_msgs + i * m_k_bytes,
+                                ws);
+    }
+}
+
+template <typename T, typename P>
+void bch_codec<T, P>::decode_zero_copy(u8_cptr_t codewords,
+                                       uint32_t n_codewords,
+                                       u8_cptr_t* decoded_msgs,
+                                       int* corrections,
+                                       bch_workspace_t<T, P>& ws) const
+{
+    assert_byte_aligned_n_k(m_n, m_k);
+    if (ws.parity.size() < n_codewords)
+        ws.parity.resize(n_codewords, gf2_poly<P>(0));
+    gen_poly_rem(codewords, n_codewords, ws.parity.data());
+
+    // Reserve the space for the corrected copies upfront, so that the pointers into the
+    // workspace do not get invalidated while the batch is decoded.
+    uint32_t n_with_errors = 0;
+    for (uint32_t i = 0; i < n_codewords; i++)
+        n_with_errors += !ws.parity[i].is_zero();
+    if (ws.corrected_msgs.size() < n_with_errors * m_k_bytes)
+        ws.corrected_msgs.resize(n_with_errors * m_k_bytes);
+
+    u8_ptr_t corrected_msg = ws.corrected_msgs.data();
+    for (uint32_t i = 0; i < n_codewords; i++) {
+        u8_cptr_t codeword = codewords + i * m_n_bytes;
+        if (ws.parity[i].is_zero()) { // error-free, so forward the systematic bytes
+            decoded_msgs[i] = codeword;
+            corrections[i] = 0;
+            continue;
+        }
+        decoded_msgs[i] = corrected_msg;
+        corrections[i] = decode(codeword, ws.parity[i], corrected_msg, ws);
+        corrected_msg += m_k_bytes;
     }
 }
 
@@ -10,14 +10,46 @@
 #define INCLUDED_DVBS2RX_BCH_H
 
 #include "gf.h"
+#include "gf_chien.h"
 #include "gf_util.h"
 #include <gnuradio/dvbs2rx/api.h>
 #include <array>
 #include <cstdint>
+#include <vector>
 
 namespace gr {
 namespace dvbs2rx {
 
+/**
+ * @brief Scratch memory for allocation-free BCH decoding.
+ *
+ * Holds fixed-capacity buffers for the intermediate results of the decoding steps
+ * (syndrome, error-location polynomial, and error-location numbers), sized for codes
+ * with error correction capability up to max_t. The caller should allocate a workspace
+ * once (e.g., per decoder block) and reuse it for every codeword.
+ *
+ * @tparam T Base type for the Galois Field elements.
+ * @tparam P Base type for the GF(2) generator polynomial.
+ */
+template <typename T, typename P>
+struct bch_workspace_t {
+    static constexpr int max_t = 12;                    // max error correction capability
+    static constexpr int max_sigma_len = 2 * max_t + 1; // max coefficients of sigma(x)
+    // Syndrome components S_1 to S_2t
+    std::array<T, 2 * max_t> syndrome;
+    // Rows of the table used by Berlekamp's algorithm, with the coefficients, degree and
+    // discrepancy of the candidate error-location polynomial sigma(x) on each row
+    std::array<std::array<T, max_sigma_len>, max_t + 2> sigma;
+    std::array<int, max_t + 2> sigma_degree;
+    std::array<T, max_t + 2> discrepancy;
+    // Error-location numbers
+    std::array<T, max_t> numbers;
+    // Parity polynomials of the codewords processed in a batch
+    std::vector<gf2_poly<P>> parity;
+    // Corrected copies of the messages with errors on a zero-copy decoding batch
+    u8_vector_t corrected_msgs;
+};
+
 /**
  * @brief BCH coder/decoder.
  *
@@ -28,6 +60,8 @@ template <typename T, typename P>
 class DVBS2RX_API bch_codec
 {
 private:
+    static constexpr int chien_block_len = gf_chien_block_len; // Chien search block
+
     const galois_field<T>* m_gf;           // Galois field
     uint8_t m_t;                           // error correction capability
     gf2_poly<P> m_g;                       // generator polynomial
@@ -39,10 +73,89 @@ private:
     uint32_t m_k_bytes;                    // message length in bytes
     uint32_t m_parity_bytes;               // number of parity bytes
     T m_msg_mask;                          // mask used to enforce k bits per message
-    std::array<P, 256> m_gen_poly_rem_lut; // Remainder LUT for the generator polynomial
-    bool m_gen_poly_lut_generated; // Whether the generator polynomial remainder LUT has
-                                   // been generated already
+    bool m_gen_poly_lut_generated; // Whether the generator polynomial remainder LUTs
+                                   // have been generated already
+    std::vector<uint64_t> m_gen_poly_rem_word_lut; // Word-sliced remainder LUT used by
+                                                   // the batched syndrome computation
+    std::vector<uint64_t> m_gen_poly_rem_slice_lut;      // Slice-by-8 remainder LUT
+    std::array<uint64_t, 6> m_gen_poly_rem_clmul_consts; // Folding constants
+    bool m_gen_poly_rem_clmul; // Whether to compute remainders by folding with carry-less
+                               // multiplications
     std::vector<T> m_quadratic_poly_lut; // LUT to solve quadratic error-loc polynomials
+    std::vector<T> m_chien_antilog;      // Extended antilog table for the Chien search
+    bool m_chien_avx2; // Whether to run the Chien search with AVX2 gathers
+
+    /**
+     * @brief Compute the remainder of a received codeword divided by g(x).
+     *
+     * @param codeword Pointer to the received codeword with n/8 bytes.
+     * @return gf2_poly<P> Remainder (parity polynomial).
+     * @note Uses carry-less multiplication when supported by the CPU and slice-by-8 LUTs
+     * otherwise.
+     */
+    gf2_poly<P> gen_poly_rem(u8_cptr_t codeword) const;
+
+    /**
+     * @overload
+     * @param codewords Pointer to n_codewords consecutive received codewords.
+     * @param n_codewords Number of codewords.
+     * @param rem Array with space for n_codewords resulting remainders.
+     * @note Without carry-less multiplication, computes the remainders of several
+     * codewords in lockstep (see `gf2_poly_rem_batch`).
+     */
+    void gen_poly_rem(u8_cptr_t codewords, uint32_t n_codewords, gf2_poly<P>* rem) const;
+
+    /**
+     * @brief Search the roots of an error-location polynomial (Chien search).
+     *
+     * @param sigma Coefficients of the error-location polynomial sigma(x).
+     * @param degree Degree of sigma(x), assumed to be less than or equal to t.
+     * @param numbers Array with space for "degree" resulting error-location numbers.
+     * @return int Number of error-location numbers found.
+     */
+    int chien_search(const T* sigma, int degree, T* numbers) const;
+
+    /**
+     * @brief Correct the errors indicated by a non-empty syndrome.
+     *
+     * @param syndrome Syndrome vector with 2t elements.
+     * @param decoded_msg Pointer to the k/8 bytes message to be corrected in place.
+     * @return int Number of bit errors corrected or -1 on decoding failure.
+     */
+    int correct(const std::vector<T>& syndrome, u8_ptr_t decoded_msg) const;
+
+    /**
+     * @brief Evaluate the syndrome of a non-zero parity polynomial into a workspace.
+     *
+     * @param parity_poly Remainder of the received codeword divided by g(x).
+     * @param ws Workspace where the 2t syndrome components are stored.
+     */
+    void eval_syndrome(const gf2_poly<P>& parity_poly, bch_workspace_t<T, P>& ws) const;
+
+    /**
+     * @brief Correct the errors indicated by the syndrome stored in a workspace.
+     *
+     * Same as `correct()`, but using the workspace buffers only.
+     *
+     * @param ws Workspace holding the syndrome components.
+     * @param decoded_msg Pointer to the k/8 bytes message to be corrected in place.
+     * @return int Number of bit errors corrected or -1 on decoding failure.
+     */
+    int correct(bch_workspace_t<T, P>& ws, u8_ptr_t decoded_msg) const;
+
+    /**
+     * @brief Decode one codeword whose parity polynomial is already known.
+     *
+     * @param codeword Pointer to the received codeword with n/8 bytes.
+     * @param parity_poly Remainder of the received codeword divided by g(x).
+     * @param decoded_msg Pointer to the decoded message buffer with k/8 bytes.
+     * @param ws Decoding workspace.
+     * @return int Number of bit errors corrected, 0 if error-free, or -1 on failure.
+     */
+    int decode(u8_cptr_t codeword,
+               const gf2_poly<P>& parity_poly,
+               u8_ptr_t decoded_msg,
+               bch_workspace_t<T, P>& ws) const;
 
 public:
     /**
@@ -105,6 +218,18 @@ public:
      */
     std::vector<T> syndrome(u8_cptr_t codeword) const;
 
+    /**
+     * @overload
+     * @param codewords Pointer to u8 array with n_codewords consecutive received
+     * codewords of n/8 bytes each.
+     * @param n_codewords Number of codewords.
+     * @return std::vector<std::vector<T>> Syndromes of the given codewords, in order,
+     * each an empty vector when the corresponding codeword is error-free.
+     * @note Computes the remainders of several codewords in lockstep, which is
+     * considerably faster than computing the syndromes one codeword at a time.
+     */
+    std::vector<std::vector<T>> syndrome(u8_cptr_t codewords, uint32_t n_codewords) const;
+
     /**
      * @brief Compute the error-location polynomial.
      *
@@ -150,6 +275,67 @@ public:
      */
     int decode(u8_cptr_t codeword, u8_ptr_t decoded_msg) const;
 
+    /**
+     * @overload
+     * @param codeword Pointer to the received codeword with n/8 bytes.
+     * @param decoded_msg Pointer to the decoded message buffer with space for k/8 bytes.
+     * @param ws Decoding workspace.
+     * @return int Number of bit errors corrected, 0 if error-free, or -1 on failure.
+     * @note Allocation-free alternative to the above. It requires t <= max_t.
+     */
+    int decode(u8_cptr_t codeword, u8_ptr_t decoded_msg, bch_workspace_t<T, P>& ws) const;
+
+    /**
+     * @overload
+     * @param codewords Pointer to n_codewords consecutive received codewords with n/8
+     * bytes each.
+     * @param decoded_msgs Pointer to the decoded message buffer with space for
+     * n_codewords messages of k/8 bytes each.
+     * @param n_codewords Number of codewords to decode.
+     * @param corrections Array with space for n_codewords results, each set to the
+     * number of bit errors corrected on the corresponding codeword, 0 when the codeword
+     * is error-free, or -1 on decoding failure.
+     * @param ws Decoding workspace.
+     * @note Equivalent to decoding each codeword individually, except that the
+     * syndromes of all codewords are computed in a single batched pass.
+     * @note This implementation uses the given workspace for all intermediate results,
+     * so it does not allocate memory in the steady state. It requires t <= max_t.
+     */
+    void decode(u8_cptr_t codewords,
+                u8_ptr_t decoded_msgs,
+                uint32_t n_codewords,
+                int* corrections,
+                bch_workspace_t<T, P>& ws) const;
+
+    /**
+     * @brief Decode codewords without copying the error-free messages.
+     *
+     * Since the code is systematic, the message of an error-free codeword is readily
+     * available on its first k/8 bytes. Hence, instead of copying every message into an
+     * output buffer, this function points each decoded message to the codeword itself
+     * when the codeword is error-free, and only copies the message into the workspace
+     * when it has errors to be corrected.
+     *
+     * @param codewords Pointer to n_codewords consecutive received codewords with n/8
+     * bytes each.
+     * @param n_codewords Number of codewords to decode.
+     * @param decoded_msgs Array with space for n_codewords resulting pointers, each set
+     * to the k/8 bytes of the corresponding decoded message, either within the codeword
+     * or within the workspace.
+     * @param corrections Array with space for n_codewords results, each set to the
+     * number of bit errors corrected on the corresponding codeword, 0 when the codeword
+     * is error-free, or -1 on decoding failure.
+     * @param ws Decoding workspace.
+     * @note The resulting pointers remain valid until the codewords buffer is released or
+     * the workspace is used again, whichever comes first.
+     * @note It requires t <= max_t.
+     */
+    void decode_zero_copy(u8_cptr_t codewords,
+                          uint32_t n_codewords,
+                          u8_cptr_t* decoded_msgs,
+                          int* corrections,
+                          bch_workspace_t<T, P>& ws) const;
+
     /**
      * @brief Get the generator polynomial object.
      *
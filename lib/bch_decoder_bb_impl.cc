@@ -16,7 +16,9 @@
 #include "fec_params.h"
 #include <gnuradio/io_signature.h>
 #include <gnuradio/logger.h>
+#include <algorithm>
 #include <functional>
+#include <stdexcept>
 // BCH Code
 #define BCH_CODE_N8 0
 #define BCH_CODE_N10 1
@@ -31,10 +33,11 @@ bch_decoder_bb::sptr bch_decoder_bb::make(dvb_standard_t standard,
                                           dvb_framesize_t framesize,
                                           dvb_code_rate_t rate,
                                           dvb_outputmode_t outputmode,
-                                          int debug_level)
+                                          int debug_level,
+                                          int num_threads)
 {
-    return gnuradio::get_initial_sptr(
-        new bch_decoder_bb_impl(standard, framesize, rate, outputmode, debug_level));
+    return gnuradio::get_initial_sptr(new bch_decoder_bb_impl(
+        standard, framesize, rate, outputmode, debug_level, num_threads));
 }
 
 /*
@@ -44,7 +47,8 @@ bch_decoder_bb_impl::bch_decoder_bb_impl(dvb_standard_t standard,
                                          dvb_framesize_t framesize,
                                          dvb_code_rate_t rate,
                                          dvb_outputmode_t outputmode,
-                                         int debug_level)
+                                         int debug_level,
+                                         int num_threads)
     : gr::block("bch_decoder_bb",
                 gr::io_signature::make(1, 1, sizeof(unsigned char)),
                 gr::io_signature::make(1, 1, sizeof(unsigned char))),
@@ -68,6 +72,11 @@ bch_decoder_bb_impl::bch_decoder_bb_impl(dvb_standard_t standard,
     d_n_bytes = fec_info.bch.n / 8;
     set_output_multiple(d_k_bytes);
     set_relative_rate((double)fec_info.bch.k / fec_info.bch.n);
+
+    if (num_threads < 1)
+        throw std::runtime_error("The number of BCH decoding threads must be >= 1");
+    d_workspace.resize(num_threads);
+    d_pool.reset(new worker_pool(num_threads));
 }
 
 /*
@@ -89,10 +98,29 @@ int bch_decoder_bb_impl::general_work(int noutput_items,
     const unsigned char* in = (const unsigned char*)input_items[0];
     unsigned char* out = (unsigned char*)output_items[0];
 
-    int consumed = 0;
-    int n_codewords = noutput_items / d_k_bytes;
+    const int n_codewords = noutput_items / d_k_bytes;
+    if (static_cast<int>(d_corrections.size()) < n_codewords)
+        d_corrections.resize(n_codewords);
+
+    // Split the codewords into contiguous chunks and decode each chunk at once so that
+    // its syndromes are computed in one pass. With multiple threads, use a few chunks
+    // per thread, given that the workers pick the chunks dynamically and the decoding
+    // cost varies widely across codewords (error-free codewords are much cheaper). Each
+    // chunk writes into its own output slice, so the output order is preserved.
+    const int n_chunks =
+        std::min(n_codewords, (int)d_pool->size() * (d_pool->size() > 1 ? 4 : 1));
+    d_pool->parallel_for(n_chunks, [&](size_t i_chunk, unsigned int i_worker) {
+        const int start = (n_codewords * i_chunk) / n_chunks;
+        const int end = (n_codewords * (i_chunk + 1)) / n_chunks;
+        d_codec->decode(in + start * d_n_bytes,
+                        out + start * d_k_bytes,
+                        end - start,
+                        d_corrections.data() + start,
+                        d_workspace[i_worker]);
+    });
+
     for (int i = 0; i < n_codewords; i++) {
-        const int corrections = d_codec->decode(in, out);
+        const int corrections = d_corrections[i];
         if (corrections > 0) {
             GR_LOG_DEBUG_LEVEL(1,
                                "frame = {:d}, BCH decoder corrections = {:d}",
@@ -107,12 +135,9 @@ int bch_decoder_bb_impl::general_work(int noutput_items,
                 ((double)d_frame_error_cnt / (d_frame_cnt + 1)));
         }
         d_frame_cnt++;
-        in += d_n_bytes;
-        out += d_k_bytes;
-        consumed += d_n_bytes;
     }
 
-    consume_each(consumed);
+    consume_each(n_codewords * d_n_bytes);
     return noutput_items;
 }
 
@@ -11,8 +11,10 @@
 #define INCLUDED_DVBS2RX_BCH_DECODER_BB_IMPL_H
 
 #include "bch.h"
+#include "worker_pool.h"
 #include <gnuradio/dvbs2rx/bch_decoder_bb.h>
 #include <memory>
+#include <vector>
 
 namespace gr {
 namespace dvbs2rx {
@@ -27,13 +29,18 @@ private:
     std::unique_ptr<bch_codec<uint32_t, bitset256_t>> d_codec;
     uint64_t d_frame_cnt;
     uint64_t d_frame_error_cnt;
+    std::vector<int> d_corrections; // number of corrections per codeword in a work call
+    // BCH decoding scratch memory for each worker thread
+    std::vector<bch_workspace_t<uint32_t, bitset256_t>> d_workspace;
+    std::unique_ptr<worker_pool> d_pool; // decoding thread pool
 
 public:
     bch_decoder_bb_impl(dvb_standard_t standard,
                         dvb_framesize_t framesize,
                         dvb_code_rate_t rate,
                         dvb_outputmode_t outputmode,
-                        int debug_level);
+                        int debug_level,
+                        int num_threads);
     ~bch_decoder_bb_impl();
 
     void forecast(int noutput_items, gr_vector_int& ninput_items_required);
@@ -0,0 +1,246 @@
+/* -*- c++ -*- */
+/*
+ * Copyright (c) 2024 Igor Freire.
+ *
+ * This file is part of gr-dvbs2rx.
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#ifndef INCLUDED_DVBS2RX_BITSET256_H
+#define INCLUDED_DVBS2RX_BITSET256_H
+
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+
+namespace gr {
+namespace dvbs2rx {
+
+/**
+ * @brief Get the index of the most significant bit set on a non-zero 64-bit word.
+ *
+ * @param x Non-zero word.
+ * @return int Bit index from 0 to 63.
+ */
+inline int msb_index_u64(uint64_t x)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return 63 - __builtin_clzll(x);
+#else
+    int i = 0;
+    while (x >>= 1)
+        i++;
+    return i;
+#endif
+}
+
+/**
+ * @brief 256-bit register for the coefficients of GF(2) polynomials.
+ *
+ * Drop-in replacement for std::bitset<256> in the GF(2) polynomial arithmetic, with the
+ * bits held on four 64-bit words. Unlike std::bitset, the shifts move whole words at a
+ * time, and the index of the most significant bit set (i.e., the polynomial degree) is
+ * found with one count-leading-zeros instruction per word instead of one bit test per
+ * bit. The bitwise operations are plain loops over the four words, which the compiler
+ * maps into SIMD registers when available.
+ */
+class bitset256_t
+{
+private:
+    static constexpr int n_words = 4;
+    uint64_t m_words[n_words]; // least significant word first
+
+public:
+    /**
+     * @brief Construct a zero-initialized bitset.
+     */
+    constexpr bitset256_t() : m_words{ 0, 0, 0, 0 } {}
+
+    /**
+     * @brief Construct a bitset whose 64 least significant bits are given by a value.
+     *
+     * @param val Value of the least significant word.
+     */
+    constexpr bitset256_t(uint64_t val) : m_words{ val, 0, 0, 0 } {}
+
+    /**
+     * @brief Get the number of bits in the bitset.
+     *
+     * @return size_t Number of bits.
+     */
+    static constexpr size_t size() { return n_words * 64; }
+
+    /**
+     * @brief Get a 64-bit word of the bitset.
+     *
+     * @param i Word index, with word 0 holding the least significant bits.
+     * @return uint64_t Word value.
+     */
+    uint64_t word(int i) const { return m_words[i]; }
+
+    /**
+     * @brief Test if a bit is set.
+     *
+     * @param pos Bit index.
+     * @return true if the bit is 1 and false otherwise.
+     */
+    bool test(size_t pos) const { return (m_words[pos / 64] >> (pos % 64)) & 1; }
+
+    /**
+     * @brief Access a bit.
+     *
+     * @param pos Bit index.
+     * @return bool Bit value.
+     */
+    bool operator[](size_t pos) const { return test(pos); }
+
+    /**
+     * @brief Set a bit.
+     *
+     * @param pos Bit index.
+     * @param value Bit value.
+     * @return bitset256_t& Reference to this bitset.
+     */
+    bitset256_t& set(size_t pos, bool value = true)
+    {
+        uint64_t& word = m_words[pos / 64];
+        const uint64_t mask = 1ULL << (pos % 64);
+        word = value ? (word | mask) : (word & ~mask);
+        return *this;
+    }
+
+    /**
+     * @brief Clear a bit.
+     *
+     * @param pos Bit index.
+     * @return bitset256_t& Reference to this bitset.
+     */
+    bitset256_t& reset(size_t pos) { return set(pos, false); }
+
+    /**
+     * @brief Test if any bit is set.
+     *
+     * @return true if the bitset is non-zero and false otherwise.
+     */
+    bool any() const { return (m_words[0] | m_words[1] | m_words[2] | m_words[3]) != 0; }
+
+    /**
+     * @brief Test if no bit is set.
+     *
+     * @return true if the bitset is zero and false otherwise.
+     */
+    bool none() const { return !any(); }
+
+    /**
+     * @brief Get the index of the most significant bit set.
+     *
+     * @return int Bit index, or -1 if no bit is set.
+     */
+    int msb_index() const
+    {
+        for (int w = n_words - 1; w >= 0; w--) {
+            if (m_words[w])
+                return w * 64 + msb_index_u64(m_words[w]);
+        }
+        return -1;
+    }
+
+    /**
+     * @brief Convert the bitset to an unsigned long integer.
+     *
+     * @return unsigned long Integer value.
+     * @throws std::overflow_error if the value does not fit in an unsigned long.
+     */
+    unsigned long to_ulong() const
+    {
+        const int msb = msb_index();
+        if (msb >= static_cast<int>(sizeof(unsigned long) * 8))
+            throw std::overflow_error("bitset256_t value does not fit in unsigned long");
+        return static_cast<unsigned long>(m_words[0]);
+    }
+
+    bitset256_t& operator^=(const bitset256_t& x)
+    {
+        for (int w = 0; w < n_words; w++)
+            m_words[w] ^= x.m_words[w];
+        return *this;
+    }
+
+    bitset256_t& operator&=(const bitset256_t& x)
+    {
+        for (int w = 0; w < n_words; w++)
+            m_words[w] &= x.m_words[w];
+        return *this;
+    }
+
+    bitset256_t& operator|=(const bitset256_t& x)
+    {
+        for (int w = 0; w < n_words; w++)
+            m_words[w] |= x.m_words[w];
+        return *this;
+    }
+
+    bitset256_t operator~() const
+    {
+        bitset256_t res;
+        for (int w = 0; w < n_words; w++)
+            res.m_words[w] = ~m_words[w];
+        return res;
+    }
+
+    bitset256_t operator<<(size_t n) const
+    {
+        bitset256_t res;
+        if (n >= size())
+            return res;
+        const int n_word_shift = n / 64;
+        const int n_bit_shift = n % 64;
+        for (int w = n_words - 1; w >= n_word_shift; w--) {
+            const int src = w - n_word_shift;
+            res.m_words[w] = m_words[src] << n_bit_shift;
+            if (n_bit_shift && src > 0)
+                res.m_words[w] |= m_words[src - 1] >> (64 - n_bit_shift);
+        }
+        return res;
+    }
+
+    bitset256_t operator>>(size_t n) const
+    {
+        bitset256_t res;
+        if (n >= size())
+            return res;
+        const int n_word_shift = n / 64;
+        const int n_bit_shift = n % 64;
+        for (int w = 0; w < n_words - n_word_shift; w++) {
+            const int src = w + n_word_shift;
+            res.m_words[w] = m_words[src] >> n_bit_shift;
+            if (n_bit_shift && src < n_words - 1)
+                res.m_words[w] |= m_words[src + 1] << (64 - n_bit_shift);
+        }
+        return res;
+    }
+
+    bitset256_t& operator<<=(size_t n) { return *this = *this << n; }
+
+    bitset256_t& operator>>=(size_t n) { return *this = *this >> n; }
+
+    bool operator==(const bitset256_t& x) const
+    {
+        return ((m_words[0] ^ x.m_words[0]) | (m_words[1] ^ x.m_words[1]) |
+                (m_words[2] ^ x.m_words[2]) | (m_words[3] ^ x.m_words[3])) == 0;
+    }
+
+    bool operator!=(const bitset256_t& x) const { return !(*this == x); }
+};
+
+inline bitset256_t operator^(bitset256_t a, const bitset256_t& b) { return a ^= b; }
+
+inline bitset256_t operator&(bitset256_t a, const bitset256_t& b) { return a &= b; }
+
+inline bitset256_t operator|(bitset256_t a, const bitset256_t& b) { return a |= b; }
+
+} // namespace dvbs2rx
+} // namespace gr
+
+#endif // INCLUDED_DVBS2RX_BITSET256_H
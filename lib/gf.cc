@@ -20,8 +20,9 @@ template <typename T>
 galois_field<T>::galois_field(const gf2_poly<T>& prim_poly)
     : m_m(prim_poly.degree()),
       m_two_to_m_minus_one((1 << m_m) - 1),
-      m_table(1 << m_m),              // GF(2^m) has 2^m elements
-      m_table_nonzero((1 << m_m) - 1) // among which 2^m - 1 are non-zero
+      m_table(1 << m_m),                     // GF(2^m) has 2^m elements
+      m_table_nonzero(2 * ((1 << m_m) - 1)), // among which 2^m - 1 are non-zero
+      m_exp_table(1 << m_m)                  // exponent of each element
 {
     // The field elements can be represented with m bits each. However, the minimal
     // polynomials can have degree up to m such that they need a storage of "m + 1" bits
@@ -58,30 +59,22 @@ galois_field<T>::galois_field(const gf2_poly<T>& prim_poly)
     // directly to the index at the m_table_nonzero vector, which makes the lookup
     // slightly faster. This strategy can make a difference when many lookups are
     // required, as in the polynomial root search (search_roots_in_exp_range() method).
-    for (uint32_t i = 0; i < m_two_to_m_minus_one; i++)
+    //
+    // Furthermore, store the non-zero elements twice, such that alpha^i can be looked up
+    // with no modulo reduction for any i up to "2*(2^m - 1) - 1". This range covers the
+    // sum of any two exponents, so that multiplications and divisions can index the
+    // table directly with the sum of the exponents of their operands.
+    for (uint32_t i = 0; i < m_two_to_m_minus_one; i++) {
         m_table_nonzero[i] = m_table[i + 1];
+        m_table_nonzero[i + m_two_to_m_minus_one] = m_table[i + 1];
+    }
 
     // Inverse LUT (Exponent LUT): map each non-zero element alpha^i to its exponent i.
+    // Since the elements are m-bit values, a dense array with 2^m entries indexed by the
+    // element value can hold this map, and it is much faster to access than a hash map.
+    // The entry at index 0 is unused since the zero element has no exponent.
     for (uint32_t i = 0; i < m_two_to_m_minus_one; i++)
-        m_exp_table.insert({ m_table_nonzero[i], i }); // m_table_nonzero[i] = alpha^i
-}
-
-template <typename T>
-T galois_field<T>::multiply(const T& a, const T& b) const
-{
-    if (a == 0 || b == 0)
-        return 0;
-    return get_alpha_i(get_exponent(a) + get_exponent(b));
-}
-
-template <typename T>
-T galois_field<T>::inverse(const T& beta) const
-{
-    // We want "beta^-1" such that "beta * beta^-1 = 1". For that, we use the property
-    // that any GF(2^m) element raised to the power "2^m - 1" is equal to one, i.e.,
-    // "beta^(2^m - 1) = 1". Hence, if beta is alpha^j (the j-th power of the primitive
-    // element), then beta^-1 must be the element alpha^k such that "j + k = 2^m - 1".
-    return get_alpha_i(m_two_to_m_minus_one - get_exponent(beta));
+        m_exp_table[m_table_nonzero[i]] = i; // m_table_nonzero[i] = alpha^i
 }
 
 template <typename T>
@@ -91,12 +84,6 @@ T galois_field<T>::inverse_by_exp(uint32_t i) const
     return get_alpha_i(m_two_to_m_minus_one - i);
 }
 
-template <typename T>
-T galois_field<T>::divide(const T& a, const T& b) const
-{
-    return multiply(a, inverse(b));
-}
-
 template <typename T>
 std::set<T> galois_field<T>::get_conjugates(const T& beta) const
 {
@@ -138,14 +125,8 @@ gf2_poly<T> galois_field<T>::get_min_poly(const T& beta) const
 template <typename T>
 gf2_poly<T>::gf2_poly(const T& coefs) : m_poly(coefs)
 {
-    // Polynomial degree
-    m_degree = -1; // convention for the zero polynomial
-    for (int i = m_max_degree; i >= 0; i--) {
-        if (is_bit_set(m_poly, i)) {
-            m_degree = i;
-            break;
-        }
-    }
+    // Polynomial degree (by convention, -1 for the zero polynomial)
+    m_degree = get_msb_index(m_poly);
 }
 
 
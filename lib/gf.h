@@ -10,21 +10,18 @@
 #ifndef INCLUDED_DVBS2RX_GF_H
 #define INCLUDED_DVBS2RX_GF_H
 
+#include "bitset256.h"
 #include <gnuradio/dvbs2rx/api.h>
-#include <unordered_map>
-#include <bitset>
 #include <cstdint>
 #include <limits>
 #include <set>
 #include <stdexcept>
+#include <type_traits>
 #include <vector>
 
 namespace gr {
 namespace dvbs2rx {
 
-// Non-int types for storing GF(2) coefficients or GF(2^m) elements:
-typedef std::bitset<256> bitset256_t;
-
 template <typename T>
 class DVBS2RX_API gf2_poly;
 
@@ -65,11 +62,11 @@ template <typename T>
 class DVBS2RX_API galois_field
 {
 private:
-    const uint8_t m_m;                           // dimension of the GF(2^m) field
-    const uint32_t m_two_to_m_minus_one;         // shortcut for (2^m - 1)
-    std::vector<T> m_table;                      // field elements
-    std::vector<T> m_table_nonzero;              // non-zero field elements
-    std::unordered_map<T, uint32_t> m_exp_table; // map element alpha^i to its exponent i
+    const uint8_t m_m;                   // dimension of the GF(2^m) field
+    const uint32_t m_two_to_m_minus_one; // shortcut for (2^m - 1)
+    std::vector<T> m_table;              // field elements
+    std::vector<T> m_table_nonzero;      // non-zero elements alpha^i (antilog table)
+    std::vector<uint32_t> m_exp_table;   // exponent i of each alpha^i (log table)
 
 public:
     /**
@@ -105,9 +102,15 @@ public:
      * @return T Exponent i.
      * @note This function cannot obtain the exponent of the zero (additive identity)
      * element, given the zero element cannot be expressed as a power of the primitive
-     * element alpha. A runtime error exception is raised if beta is the zero element.
+     * element alpha. An std::out_of_range exception is raised if beta is the zero
+     * element or is not an element of the field.
      */
-    uint32_t get_exponent(const T& beta) const { return m_exp_table.at(beta); }
+    uint32_t get_exponent(const T& beta) const
+    {
+        if (beta == 0)
+            throw std::out_of_range("The zero element has no exponent");
+        return m_exp_table.at(beta);
+    }
 
     /**
      * @brief Multiply two elements from GF(2^m).
@@ -116,7 +119,14 @@ public:
      * @param b Second multiplicand.
      * @return T Product a*b.
      */
-    T multiply(const T& a, const T& b) const;
+    T multiply(const T& a, const T& b) const
+    {
+        if (a == 0 || b == 0)
+            return 0;
+        // The sum of exponents is less than 2*(2^m - 1), so it indexes the extended
+        // antilog table directly with no modulo reduction.
+        return m_table_nonzero[get_exponent(a) + get_exponent(b)];
+    }
 
     /**
      * @brief Get the inverse beta^-1 from a GF(2^m) element beta.
@@ -124,7 +134,15 @@ public:
      * @param beta Element to invert.
      * @return T Inverse beta^-1.
      */
-    T inverse(const T& beta) const;
+    T inverse(const T& beta) const
+    {
+        // We want "beta^-1" such that "beta * beta^-1 = 1". For that, we use the property
+        // that any GF(2^m) element raised to the power "2^m - 1" is equal to one, i.e.,
+        // "beta^(2^m - 1) = 1". Hence, if beta is alpha^j (the j-th power of the
+        // primitive element), then beta^-1 must be the element alpha^k such that "j + k =
+        // 2^m - 1".
+        return m_table_nonzero[m_two_to_m_minus_one - get_exponent(beta)];
+    }
 
     /**
      * @brief Get the inverse from a GF(2^m) element alpha^i given by its exponent i.
@@ -141,7 +159,13 @@ public:
      * @param b Divisor.
      * @return T Quotient a/b.
      */
-    T divide(const T& a, const T& b) const;
+    T divide(const T& a, const T& b) const
+    {
+        const uint32_t inv_b_exp = m_two_to_m_minus_one - get_exponent(b);
+        if (a == 0)
+            return 0;
+        return m_table_nonzero[get_exponent(a) + inv_b_exp];
+    }
 
     /**
      * @brief Get the conjugates of element beta.
@@ -188,7 +212,37 @@ inline constexpr size_t get_max_gf2_poly_degree()
 template <>
 inline constexpr size_t get_max_gf2_poly_degree<bitset256_t>()
 {
-    return bitset256_t().size() - 1;
+    return bitset256_t::size() - 1;
+}
+
+/**
+ * @brief Get the index of the most significant bit set on a bit register.
+ *
+ * @param x Bit register.
+ * @return int Bit index, or -1 if no bit is set.
+ */
+template <typename T>
+inline int get_msb_index(const T& x)
+{
+    if constexpr (std::is_unsigned_v<T>) {
+        return x ? msb_index_u64(x) : -1;
+    } else {
+        for (int i = get_max_gf2_poly_degree<T>(); i >= 0; i--) {
+            if (is_bit_set(x, i))
+                return i;
+        }
+        return -1;
+    }
+}
+
+/**
+ * @overload
+ * @note Template specialization for T = bitset256_t.
+ */
+template <>
+inline int get_msb_index(const bitset256_t& x)
+{
+    return x.msb_index();
 }
 
 /**
@@ -304,10 +358,9 @@ inline gf2_poly<Tb> operator%(const gf2_poly<Ta> a, const gf2_poly<Tb> b)
     int b_degree = b.degree();
     const Tb b_coefs = b.get_poly();
     Tb remainder = a.get_poly(); // here type Tb must be large enough to store a(x)
-    for (int i = a.degree(); i >= b_degree; i--) {
-        if (is_bit_set(remainder, i))
-            remainder ^= b_coefs << (i - b_degree);
-    }
+    // Jump straight to the next non-zero coefficient after each subtraction of b(x)
+    for (int i = a.degree(); i >= b_degree; i = get_msb_index(remainder))
+        remainder ^= b_coefs << (i - b_degree);
     return remainder;
 }
 
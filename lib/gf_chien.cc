@@ -0,0 +1,111 @@
+/* -*- c++ -*- */
+/*
+ * Copyright (c) 2024 Igor Freire.
+ *
+ * This file is part of gr-dvbs2rx.
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#include "gf_chien.h"
+#include "cpu_features_macros.h"
+#include <stdexcept>
+
+#ifdef CPU_FEATURES_ARCH_X86
+#include "cpuinfo_x86.h"
+#include <immintrin.h>
+using namespace cpu_features;
+#endif
+
+namespace gr {
+namespace dvbs2rx {
+
+bool gf_chien_avx2_supported()
+{
+#if defined(CPU_FEATURES_ARCH_X86)
+    return GetX86Info().features.avx2;
+#else
+    return false;
+#endif
+}
+
+#if defined(CPU_FEATURES_ARCH_X86)
+
+// Each 32-bit lane of the accumulators evaluates one exponent of the block, so the eight
+// accumulators cover the 64 exponents. For each term, gather the antilog entries of
+// eight consecutive exponents at a time, whose indexes are spaced by the term's order.
+// The 16-bit table is gathered 32 bits at a time with a scale of 2, so the upper half of
+// each lane holds the next table entry, which is masked out before the zero check.
+static constexpr int n_vecs = gf_chien_block_len / 8;
+
+template <int scale, typename T>
+static inline uint64_t
+search_block(const T* antilog, const uint32_t* exps, const uint32_t* steps, int n_terms)
+{
+    const int* table = reinterpret_cast<const int*>(antilog);
+    const __m256i lanes = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+    __m256i acc[n_vecs];
+    for (int v = 0; v < n_vecs; v++)
+        acc[v] = _mm256_setzero_si256();
+
+    for (int j = 0; j < n_terms; j++) {
+        const __m256i step = _mm256_set1_epi32(steps[j]);
+        const __m256i step8 = _mm256_slli_epi32(step, 3);
+        __m256i idx = _mm256_add_epi32(_mm256_set1_epi32(exps[j]),
+                                       _mm256_mullo_epi32(lanes, step));
+        for (int v = 0; v < n_vecs; v++) {
+            acc[v] = _mm256_xor_si256(acc[v], _mm256_i32gather_epi32(table, idx, scale));
+            idx = _mm256_add_epi32(idx, step8);
+        }
+    }
+
+    const __m256i mask = _mm256_set1_epi32((scale == 2) ? 0xFFFF : -1);
+    const __m256i zero = _mm256_setzero_si256();
+    uint64_t roots = 0;
+    for (int v = 0; v < n_vecs; v++) {
+        const __m256i is_root =
+            _mm256_cmpeq_epi32(_mm256_and_si256(acc[v], mask), zero);
+        const uint64_t bits = _mm256_movemask_ps(_mm256_castsi256_ps(is_root));
+        roots |= bits << (8 * v);
+    }
+    return roots;
+}
+
+uint64_t gf_chien_search_block_avx2(const uint16_t* antilog,
+                                    const uint32_t* exps,
+                                    const uint32_t* steps,
+                                    int n_terms)
+{
+    return search_block<2>(antilog, exps, steps, n_terms);
+}
+
+uint64_t gf_chien_search_block_avx2(const uint32_t* antilog,
+                                    const uint32_t* exps,
+                                    const uint32_t* steps,
+                                    int n_terms)
+{
+    return search_block<4>(antilog, exps, steps, n_terms);
+}
+
+#else
+
+uint64_t gf_chien_search_block_avx2(const uint16_t* antilog,
+                                    const uint32_t* exps,
+                                    const uint32_t* steps,
+                                    int n_terms)
+{
+    throw std::runtime_error("AVX2 Chien search not supported");
+}
+
+uint64_t gf_chien_search_block_avx2(const uint32_t* antilog,
+                                    const uint32_t* exps,
+                                    const uint32_t* steps,
+                                    int n_terms)
+{
+    throw std::runtime_error("AVX2 Chien search not supported");
+}
+
+#endif
+
+} // namespace dvbs2rx
+} // namespace gr
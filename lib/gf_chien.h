@@ -0,0 +1,67 @@
+/* -*- c++ -*- */
+/*
+ * Copyright (c) 2024 Igor Freire.
+ *
+ * This file is part of gr-dvbs2rx.
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#ifndef INCLUDED_DVBS2RX_GF_CHIEN_H
+#define INCLUDED_DVBS2RX_GF_CHIEN_H
+
+#include <gnuradio/dvbs2rx/api.h>
+#include <cstdint>
+
+namespace gr {
+namespace dvbs2rx {
+
+/**
+ * @brief Number of consecutive exponents evaluated per Chien search block.
+ */
+constexpr int gf_chien_block_len = 64;
+
+/**
+ * @brief Check whether the CPU supports the vectorized Chien search.
+ *
+ * @return true if the CPU implements AVX2 and the library was built for x86, false
+ * otherwise.
+ */
+DVBS2RX_API bool gf_chien_avx2_supported();
+
+/**
+ * @brief Evaluate a polynomial over a block of consecutive powers of alpha.
+ *
+ * Computes the sum over j of antilog[exps[j] + k * steps[j]] for each of the
+ * gf_chien_block_len exponents k of the block, eight exponents at a time using AVX2
+ * gather instructions, and flags the exponents where the sum is zero (the roots).
+ *
+ * @param antilog Antilog table mapping each exponent i to alpha^i, extended such that
+ * all indexes of the block are within the table, plus one padding element for the
+ * 16-bit overload, whose gathers read 32 bits at a time.
+ * @param exps Antilog table index of each non-zero term of the polynomial on the first
+ * exponent of the block.
+ * @param steps Order of each non-zero term, i.e., the index step from one exponent of
+ * the block to the next.
+ * @param n_terms Number of non-zero terms.
+ * @return uint64_t Bitmask with bit k set if the polynomial evaluates to zero on the
+ * k-th exponent of the block.
+ * @note Only call this function if gf_chien_avx2_supported() returns true.
+ */
+DVBS2RX_API uint64_t gf_chien_search_block_avx2(const uint16_t* antilog,
+                                                const uint32_t* exps,
+                                                const uint32_t* steps,
+                                                int n_terms);
+
+/**
+ * @overload
+ */
+DVBS2RX_API uint64_t gf_chien_search_block_avx2(const uint32_t* antilog,
+                                                const uint32_t* exps,
+                                                const uint32_t* steps,
+                                                int n_terms);
+
+} // namespace dvbs2rx
+} // namespace gr
+
+#endif // INCLUDED_DVBS2RX_GF_CHIEN_H
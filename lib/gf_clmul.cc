@@ -0,0 +1,151 @@
+/* -*- c++ -*- */
+/*
+ * Copyright (c) 2024 Igor Freire.
+ *
+ * This file is part of gr-dvbs2rx.
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#include "gf_clmul.h"
+#include "cpu_features_macros.h"
+#include <cstring>
+#include <stdexcept>
+
+#ifdef CPU_FEATURES_ARCH_X86
+#include "cpuinfo_x86.h"
+#include <immintrin.h>
+using namespace cpu_features;
+#endif
+
+#ifdef CPU_FEATURES_ARCH_AARCH64
+#include "cpuinfo_aarch64.h"
+#include <arm_neon.h>
+using namespace cpu_features;
+#endif
+
+namespace gr {
+namespace dvbs2rx {
+
+bool gf2_clmul_supported()
+{
+#if defined(CPU_FEATURES_ARCH_X86)
+    const X86Features features = GetX86Info().features;
+    return features.pclmulqdq && features.ssse3;
+#elif defined(CPU_FEATURES_ARCH_AARCH64)
+    return GetAarch64Info().features.pmull;
+#else
+    return false;
+#endif
+}
+
+// Each folding step computes "A * x^128 + w mod g(x)" for the 256-bit accumulator A,
+// whose words are (a3, a2, a1, a0) from most to least significant, and the next 128-bit
+// block w of the dividend. The two most significant words of "A * x^128" are a3 * x^320
+// and a2 * x^256, which are replaced by their products with the 192-bit constants "x^320
+// mod g(x)" and "x^256 mod g(x)". The products have up to 255 bits, and a1 and a0 are
+// shifted into the two most significant words, so the result fits in 256 bits again.
+// Each step takes six 64x64-bit carry-less multiplications. Only the two most
+// significant words of A feed the multiplications, so the dependency chain from one
+// step to the next is a single multiplication followed by a few XORs.
+
+#if defined(CPU_FEATURES_ARCH_X86)
+
+// Load 16 bytes in network byte order into a 128-bit polynomial
+static inline __m128i load_be128(const uint8_t* p)
+{
+    const __m128i bswap =
+        _mm_set_epi8(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+    return _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p)), bswap);
+}
+
+void gf2_poly_fold_clmul(const uint8_t* y,
+                         int y_size,
+                         const uint64_t* consts,
+                         uint64_t* acc)
+{
+    // Constants "x^320 mod g(x)" on the lower lanes and "x^256 mod g(x)" on the upper
+    const __m128i k0 = _mm_set_epi64x(consts[3], consts[0]);
+    const __m128i k1 = _mm_set_epi64x(consts[4], consts[1]);
+    const __m128i k2 = _mm_set_epi64x(consts[5], consts[2]);
+
+    // Start with the leading bytes that do not fill a 128-bit block, if any
+    const int n_lead = y_size % 16;
+    uint8_t lead[16] = { 0 };
+    memcpy(lead + 16 - n_lead, y, n_lead);
+    __m128i lo = load_be128(lead);    // (a1, a0)
+    __m128i hi = _mm_setzero_si128(); // (a3, a2)
+
+    for (int i = n_lead; i < y_size; i += 16) {
+        const __m128i w = load_be128(y + i);
+        const __m128i p0 = _mm_xor_si128(_mm_clmulepi64_si128(hi, k0, 0x01),
+                                         _mm_clmulepi64_si128(hi, k0, 0x10));
+        const __m128i p1 = _mm_xor_si128(_mm_clmulepi64_si128(hi, k1, 0x01),
+                                         _mm_clmulepi64_si128(hi, k1, 0x10));
+        const __m128i p2 = _mm_xor_si128(_mm_clmulepi64_si128(hi, k2, 0x01),
+                                         _mm_clmulepi64_si128(hi, k2, 0x10));
+        hi = _mm_xor_si128(_mm_xor_si128(lo, p2), _mm_srli_si128(p1, 8));
+        lo = _mm_xor_si128(_mm_xor_si128(w, p0), _mm_slli_si128(p1, 8));
+    }
+
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(acc), lo);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(acc + 2), hi);
+}
+
+#elif defined(CPU_FEATURES_ARCH_AARCH64)
+
+static inline uint64x2_t clmul(uint64_t a, uint64_t b)
+{
+    return vreinterpretq_u64_p128(vmull_p64((poly64_t)a, (poly64_t)b));
+}
+
+// Load 16 bytes in network byte order into a 128-bit polynomial
+static inline uint64x2_t load_be128(const uint8_t* p)
+{
+    const uint64x2_t v = vreinterpretq_u64_u8(vrev64q_u8(vld1q_u8(p)));
+    return vextq_u64(v, v, 1);
+}
+
+void gf2_poly_fold_clmul(const uint8_t* y,
+                         int y_size,
+                         const uint64_t* consts,
+                         uint64_t* acc)
+{
+    const uint64x2_t zero = vdupq_n_u64(0);
+
+    // Start with the leading bytes that do not fill a 128-bit block, if any
+    const int n_lead = y_size % 16;
+    uint8_t lead[16] = { 0 };
+    memcpy(lead + 16 - n_lead, y, n_lead);
+    uint64x2_t lo = load_be128(lead); // (a1, a0)
+    uint64x2_t hi = zero;             // (a3, a2)
+
+    for (int i = n_lead; i < y_size; i += 16) {
+        const uint64x2_t w = load_be128(y + i);
+        const uint64_t a2 = vgetq_lane_u64(hi, 0);
+        const uint64_t a3 = vgetq_lane_u64(hi, 1);
+        const uint64x2_t p0 = veorq_u64(clmul(a3, consts[0]), clmul(a2, consts[3]));
+        const uint64x2_t p1 = veorq_u64(clmul(a3, consts[1]), clmul(a2, consts[4]));
+        const uint64x2_t p2 = veorq_u64(clmul(a3, consts[2]), clmul(a2, consts[5]));
+        hi = veorq_u64(veorq_u64(lo, p2), vextq_u64(p1, zero, 1));
+        lo = veorq_u64(veorq_u64(w, p0), vextq_u64(zero, p1, 1));
+    }
+
+    vst1q_u64(acc, lo);
+    vst1q_u64(acc + 2, hi);
+}
+
+#else
+
+void gf2_poly_fold_clmul(const uint8_t* y,
+                         int y_size,
+                         const uint64_t* consts,
+                         uint64_t* acc)
+{
+    throw std::runtime_error("Carry-less multiplication not supported");
+}
+
+#endif
+
+} // namespace dvbs2rx
+} // namespace gr
@@ -0,0 +1,49 @@
+/* -*- c++ -*- */
+/*
+ * Copyright (c) 2024 Igor Freire.
+ *
+ * This file is part of gr-dvbs2rx.
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#ifndef INCLUDED_DVBS2RX_GF_CLMUL_H
+#define INCLUDED_DVBS2RX_GF_CLMUL_H
+
+#include <gnuradio/dvbs2rx/api.h>
+#include <cstdint>
+
+namespace gr {
+namespace dvbs2rx {
+
+/**
+ * @brief Check whether the CPU supports carry-less multiplication.
+ *
+ * @return true if the CPU implements PCLMULQDQ (x86) or PMULL (AArch64) and the library
+ * was built for the corresponding architecture, false otherwise.
+ */
+DVBS2RX_API bool gf2_clmul_supported();
+
+/**
+ * @brief Fold a GF(2) polynomial into a 256-bit word congruent to it modulo a divisor.
+ *
+ * Computes a polynomial with degree less than 256 that is congruent to the dividend y
+ * modulo a divisor g(x) of degree up to 192. The dividend is processed in 128-bit
+ * blocks using carry-less multiplications by the constants "x^320 mod g(x)" and "x^256
+ * mod g(x)". The result still needs to be reduced modulo g(x) by the caller.
+ *
+ * @param y Dividend given by an array of bytes in network byte order (big-endian).
+ * @param y_size Size of the dividend in bytes.
+ * @param consts Folding constants "x^320 mod g(x)" and "x^256 mod g(x)", in this order,
+ * with three 64-bit words each, least significant word first.
+ * @param acc Resulting 256-bit polynomial over four 64-bit words, least significant word
+ * first.
+ * @note Only call this function if gf2_clmul_supported() returns true.
+ */
+DVBS2RX_API void
+gf2_poly_fold_clmul(const uint8_t* y, int y_size, const uint64_t* consts, uint64_t* acc);
+
+} // namespace dvbs2rx
+} // namespace gr
+
+#endif // INCLUDED_DVBS2RX_GF_CLMUL_H
@@ -11,6 +11,8 @@
 #define INCLUDED_DVBS2RX_GF_UTIL_H
 
 #include "gf.h"
+#include "gf_clmul.h"
+#include <algorithm>
 #include <array>
 #include <stdexcept>
 #include <vector>
@@ -42,10 +44,9 @@ inline T bitmask(int n_bits)
 template <>
 inline bitset256_t bitmask(int n_bits)
 {
-    bitset256_t mask;
-    for (int i = 0; i < n_bits; i++)
-        mask.set(i);
-    return mask;
+    return (n_bits >= static_cast<int>(bitset256_t::size()))
+               ? ~bitset256_t()
+               : ~(~bitset256_t() << n_bits);
 }
 
 /**
@@ -69,10 +70,7 @@ inline uint8_t get_byte(const T& value, uint32_t byte_index)
 template <>
 inline uint8_t get_byte(const bitset256_t& value, uint32_t byte_index)
 {
-    uint8_t byte = 0;
-    for (uint32_t i = byte_index * 8; i < (byte_index + 1) * 8; i++)
-        byte |= value[i] << (i - byte_index * 8);
-    return byte;
+    return value.word(byte_index / 8) >> ((byte_index % 8) * 8);
 }
 
 /**
@@ -100,9 +98,12 @@ inline uint8_t get_msby(const T& value, uint32_t lsb_index)
 template <>
 inline uint8_t get_msby(const bitset256_t& value, uint32_t lsb_index)
 {
-    uint8_t byte = 0;
-    for (uint32_t i = lsb_index; i < (lsb_index + 8); i++)
-        byte |= value[i] << (i - lsb_index);
+    // The byte may straddle two words
+    const uint32_t i_word = lsb_index / 64;
+    const uint32_t shift = lsb_index % 64;
+    uint64_t byte = value.word(i_word) >> shift;
+    if (shift > 56 && i_word < 3)
+        byte |= value.word(i_word + 1) << (64 - shift);
     return byte;
 }
 
@@ -274,6 +275,469 @@ gf2_poly_rem(const u8_vector_t& y, const gf2_poly<T>& x, const std::array<T, 256
     return gf2_poly_rem(y.data(), y.size(), x, x_lut);
 }
 
+/**
+ * @brief Get the number of leak bytes used by the word-sliced remainder computation.
+ *
+ * @param degree Degree of the divisor polynomial.
+ * @return int Minimum number of bytes that can hold a remainder of division by a
+ * polynomial with the given degree.
+ */
+inline int gf2_poly_rem_n_leak_bytes(int degree) { return std::max(1, (degree + 7) / 8); }
+
+/**
+ * @brief Build the word-sliced LUT used by `gf2_poly_rem_batch`
+ *
+ * Same principle as the LUT generated by `build_gf2_poly_rem_lut`, except that each
+ * entry spans only the minimum number of leak bytes required for the divisor x, given by
+ * `gf2_poly_rem_n_leak_bytes(x.degree())`, and is stored over 64-bit words, with the
+ * least significant leak byte at the least significant byte of the first word. This
+ * layout allows for processing the leak with plain 64-bit operations regardless of the
+ * bit storage type T.
+ *
+ * @tparam T Type whose bits represent the binary polynomial coefficients.
+ * @param x Divisor polynomial.
+ * @note The divisor should have degree less than or equal to "(sizeof(T) - 1) * 8" and
+ * less than or equal to 256.
+ * @return std::vector<uint64_t> LUT with 256 consecutive entries of
+ * ceil(n_leak_bytes / 8) words each.
+ */
+template <typename T>
+std::vector<uint64_t> build_gf2_poly_rem_word_lut(const gf2_poly<T>& x)
+{
+    const int n_leak_bytes = gf2_poly_rem_n_leak_bytes(x.degree());
+    const int n_words = (n_leak_bytes + 7) / 8;
+    if (x.degree() > static_cast<int>(sizeof(T) - 1) * 8 || n_words > 4)
+        throw std::runtime_error("Failed to compute remainder LUT. Type T is too small.");
+
+    std::vector<uint64_t> table(256 * n_words, 0);
+    for (int i = 0; i < 256; i++) {
+        gf2_poly<T> y(static_cast<T>(i) << (n_leak_bytes * 8));
+        const T rem = (y % x).get_poly();
+        for (int j = 0; j < n_leak_bytes; j++)
+            table[i * n_words + j / 8] |= static_cast<uint64_t>(get_byte(rem, j))
+                                          << ((j % 8) * 8);
+    }
+    return table;
+}
+
+/**
+ * @brief Advance interleaved remainder computations over the leading dividend bytes.
+ *
+ * @tparam W Number of 64-bit words per leak.
+ * @tparam L Number of interleaved dividends (lanes).
+ * @param y Pointers to the dividends of each lane.
+ * @param n_bytes Number of leading bytes to process on each lane.
+ * @param n_leak_bytes Number of leak bytes.
+ * @param lut Word-sliced LUT generated by `build_gf2_poly_rem_word_lut`.
+ * @param leak Resulting leak of each lane.
+ */
+template <int W, int L>
+inline void _gf2_poly_rem_lanes(const u8_cptr_t* y,
+                                int n_bytes,
+                                int n_leak_bytes,
+                                const uint64_t* lut,
+                                uint64_t (*leak)[W])
+{
+    const int top_bytes = n_leak_bytes - 8 * (W - 1); // leak bytes on the last word
+    const int msby_shift = (top_bytes - 1) * 8;
+    const uint64_t top_mask = (top_bytes == 8) ? ~0ULL : ((1ULL << (top_bytes * 8)) - 1);
+
+    for (int k = 0; k < L; k++)
+        for (int w = 0; w < W; w++)
+            leak[k][w] = 0;
+
+    // Same as in gf2_poly_rem, but advancing all lanes by one byte per iteration. The
+    // lanes form independent dependency chains, so their LUT loads and word operations
+    // can overlap in the CPU pipeline.
+    for (int i = 0; i < n_bytes; i++) {
+#pragma GCC unroll 4
+        for (int k = 0; k < L; k++) {
+            const uint8_t in_byte_plus_leak = y[k][i] ^ (leak[k][W - 1] >> msby_shift);
+            const uint64_t* entry = lut + in_byte_plus_leak * W;
+#pragma GCC unroll 4
+            for (int w = W - 1; w > 0; w--)
+                leak[k][w] = ((leak[k][w] << 8) | (leak[k][w - 1] >> 56)) ^ entry[w];
+            leak[k][0] = (leak[k][0] << 8) ^ entry[0];
+            leak[k][W - 1] &= top_mask;
+        }
+    }
+}
+
+/**
+ * @brief Combine the leak with the trailing dividend bytes and reduce the result.
+ *
+ * @tparam T Type whose bits represent the binary polynomial coefficients.
+ * @tparam W Number of 64-bit words per leak.
+ * @param y_tail Pointer to the last n_leak_bytes bytes of the dividend.
+ * @param n_leak_bytes Number of leak bytes.
+ * @param leak Leak accumulated over the preceding dividend bytes.
+ * @param x Divisor GF(2) polynomial.
+ * @return gf2_poly<T> Resulting remainder.
+ */
+template <typename T, int W>
+inline gf2_poly<T> _gf2_poly_rem_finish(u8_cptr_t y_tail,
+                                        int n_leak_bytes,
+                                        const uint64_t* leak,
+                                        const gf2_poly<T>& x)
+{
+    T val = 0;
+    for (int i = n_leak_bytes - 1; i >= 0; i--) {
+        const uint8_t leak_byte = leak[i / 8] >> ((i % 8) * 8);
+        val = (val << 8) | static_cast<T>(y_tail[n_leak_bytes - 1 - i] ^ leak_byte);
+    }
+    return gf2_poly<T>(val) % x;
+}
+
+/**
+ * @brief Compute the remainders of a batch of dividends with W-word leaks.
+ *
+ * @note See `gf2_poly_rem_batch`.
+ */
+template <typename T, int W>
+void _gf2_poly_rem_batch(u8_cptr_t y,
+                         const int y_size,
+                         const int n_polys,
+                         const gf2_poly<T>& x,
+                         const uint64_t* x_word_lut,
+                         gf2_poly<T>* rem)
+{
+    static constexpr int n_lanes = 4; // number of interleaved dividends
+    const int n_leak_bytes = gf2_poly_rem_n_leak_bytes(x.degree());
+    const int n_leading_bytes = y_size - n_leak_bytes;
+
+    int j = 0;
+    for (; j + n_lanes <= n_polys; j += n_lanes) {
+        u8_cptr_t y_lane[n_lanes];
+        uint64_t leak[n_lanes][W];
+        for (int k = 0; k < n_lanes; k++)
+            y_lane[k] = y + (j + k) * y_size;
+        _gf2_poly_rem_lanes<W, n_lanes>(
+            y_lane, n_leading_bytes, n_leak_bytes, x_word_lut, leak);
+        for (int k = 0; k < n_lanes; k++)
+            rem[j + k] = _gf2_poly_rem_finish<T, W>(
+                y_lane[k] + n_leading_bytes, n_leak_bytes, leak[k], x);
+    }
+
+    // Leftover dividends that do not fill a group of lanes
+    for (; j < n_polys; j++) {
+        u8_cptr_t y_lane[1] = { y + j * y_size };
+        uint64_t leak[1][W];
+        _gf2_poly_rem_lanes<W, 1>(
+            y_lane, n_leading_bytes, n_leak_bytes, x_word_lut, leak);
+        rem[j] = _gf2_poly_rem_finish<T, W>(
+            y_lane[0] + n_leading_bytes, n_leak_bytes, leak[0], x);
+    }
+}
+
+/**
+ * @brief Compute the remainders "y_j % x" of a batch of GF2 polynomials y_j
+ *
+ * Equivalent to calling `gf2_poly_rem` on each dividend of the batch, but considerably
+ * faster for two reasons. First, the leak carried from byte to byte is held on plain
+ * 64-bit words, which is much cheaper than operating on wide bit storage types such as
+ * bitset256_t. Second, groups of dividends are processed in lockstep. The byte-by-byte
+ * remainder computation forms a serial dependency chain through the leak, so a single
+ * dividend leaves most of the CPU's execution resources idle, whereas interleaved chains
+ * keep the LUT loads and word operations of several dividends in flight.
+ *
+ * @tparam T Type whose bits represent the binary polynomial coefficients.
+ * @param y Dividend GF(2) polynomials given by contiguous arrays of y_size bytes each,
+ * each in network byte order (big-endian).
+ * @param y_size Size of each dividend polynomial in bytes.
+ * @param n_polys Number of dividend polynomials in the batch.
+ * @param x Divisor GF(2) polynomial.
+ * @param x_word_lut LUT generated by the `build_gf2_poly_rem_word_lut` function for x.
+ * @param rem Array with space for n_polys resulting remainders.
+ */
+template <typename T>
+void gf2_poly_rem_batch(u8_cptr_t y,
+                        const int y_size,
+                        const int n_polys,
+                        const gf2_poly<T>& x,
+                        const std::vector<uint64_t>& x_word_lut,
+                        gf2_poly<T>* rem)
+{
+    // Short dividends fit entirely within the leak space and need no LUT processing
+    if (y_size <= gf2_poly_rem_n_leak_bytes(x.degree())) {
+        for (int j = 0; j < n_polys; j++)
+            rem[j] = gf2_poly<T>(from_u8_array<T>(y + j * y_size, y_size)) % x;
+        return;
+    }
+
+    switch (x_word_lut.size() / 256) {
+    case 1:
+        _gf2_poly_rem_batch<T, 1>(y, y_size, n_polys, x, x_word_lut.data(), rem);
+        break;
+    case 2:
+        _gf2_poly_rem_batch<T, 2>(y, y_size, n_polys, x, x_word_lut.data(), rem);
+        break;
+    case 3:
+        _gf2_poly_rem_batch<T, 3>(y, y_size, n_polys, x, x_word_lut.data(), rem);
+        break;
+    case 4:
+        _gf2_poly_rem_batch<T, 4>(y, y_size, n_polys, x, x_word_lut.data(), rem);
+        break;
+    default:
+        throw std::runtime_error("Invalid word-sliced remainder LUT");
+    }
+}
+
+/**
+ * @brief Build the slice-by-N LUTs used by `gf2_poly_rem_slice`
+ *
+ * Extends the word-sliced LUT generated by `build_gf2_poly_rem_word_lut` with N - 1
+ * additional tables. The s-th table maps each input byte b to the leak that b introduces
+ * when it is followed by s other bytes before the leak window, i.e., to the remainder of
+ * "b * x^(8 * (n_leak_bytes + s))" divided by x. With these tables, the remainder
+ * computation can absorb N input bytes per iteration with N independent look-ups.
+ *
+ * @tparam T Type whose bits represent the binary polynomial coefficients.
+ * @param x Divisor polynomial.
+ * @param n_slices Number of bytes N processed per iteration (4 or 8).
+ * @return std::vector<uint64_t> LUT with N tables of 256 entries, the s-th table
+ * starting at entry "s * 256", with each entry spanning ceil(n_leak_bytes / 8) words.
+ */
+template <typename T>
+std::vector<uint64_t> build_gf2_poly_rem_slice_lut(const gf2_poly<T>& x, int n_slices)
+{
+    if (n_slices != 4 && n_slices != 8)
+        throw std::invalid_argument("Unsupported number of remainder LUT slices");
+
+    const std::vector<uint64_t> word_lut = build_gf2_poly_rem_word_lut(x);
+    const int n_leak_bytes = gf2_poly_rem_n_leak_bytes(x.degree());
+    const int n_words = word_lut.size() / 256;
+    const int top_bytes = n_leak_bytes - 8 * (n_words - 1); // leak bytes on the last word
+    const int msby_shift = (top_bytes - 1) * 8;
+    const uint64_t top_mask = (top_bytes == 8) ? ~0ULL : ((1ULL << (top_bytes * 8)) - 1);
+
+    // Each table follows from the preceding one by one extra byte of delay, namely by
+    // advancing the preceding table's leak through one byte-by-byte iteration.
+    std::vector<uint64_t> table(n_slices * 256 * n_words);
+    std::copy(word_lut.begin(), word_lut.end(), table.begin());
+    for (int s = 1; s < n_slices; s++) {
+        for (int b = 0; b < 256; b++) {
+            const uint64_t* prev = table.data() + ((s - 1) * 256 + b) * n_words;
+            uint64_t* entry = table.data() + (s * 256 + b) * n_words;
+            const uint8_t msby = prev[n_words - 1] >> msby_shift;
+            for (int w = n_words - 1; w > 0; w--)
+                entry[w] = ((prev[w] << 8) | (prev[w - 1] >> 56)) ^
+                           word_lut[msby * n_words + w];
+            entry[0] = (prev[0] << 8) ^ word_lut[msby * n_words];
+            entry[n_words - 1] &= top_mask;
+        }
+    }
+    return table;
+}
+
+/**
+ * @brief Compute the leak of the leading dividend bytes with N bytes per iteration.
+ *
+ * @tparam W Number of 64-bit words per leak.
+ * @tparam N Number of bytes absorbed per iteration.
+ * @param y Pointer to the dividend.
+ * @param n_bytes Number of leading bytes to process.
+ * @param n_leak_bytes Number of leak bytes.
+ * @param lut Slice-by-N LUT generated by `build_gf2_poly_rem_slice_lut`.
+ * @param leak Resulting leak.
+ */
+template <int W, int N>
+inline void _gf2_poly_rem_slice_leading(
+    u8_cptr_t y, int n_bytes, int n_leak_bytes, const uint64_t* lut, uint64_t* leak)
+{
+    const int top_bytes = n_leak_bytes - 8 * (W - 1); // leak bytes on the last word
+    const int msby_shift = (top_bytes - 1) * 8;
+    const uint64_t top_mask = (top_bytes == 8) ? ~0ULL : ((1ULL << (top_bytes * 8)) - 1);
+
+    for (int w = 0; w < W; w++)
+        leak[w] = 0;
+
+    int i = 0;
+    for (; i + N <= n_bytes; i += N) {
+        // Incorporate the preceding leak into the next N input bytes. The leak is aligned
+        // with the first input byte, so its most significant bytes meet the first bytes.
+        uint8_t idx[N];
+#pragma GCC unroll 8
+        for (int j = 0; j < N; j++) {
+            const int k = n_leak_bytes - 1 - j; // leak byte meeting the j-th input byte
+            const uint8_t leak_byte = (k >= 0) ? (leak[k / 8] >> ((k % 8) * 8)) : 0;
+            idx[j] = y[i + j] ^ leak_byte;
+        }
+
+        // The leak bytes beyond the N input bytes (if any) are carried forward
+        if constexpr (N == 8) {
+            for (int w = W - 1; w > 0; w--)
+                leak[w] = leak[w - 1];
+            leak[0] = 0;
+        } else {
+            for (int w = W - 1; w > 0; w--)
+                leak[w] = (leak[w] << (8 * N)) | (leak[w - 1] >> (64 - 8 * N));
+            leak[0] <<= (8 * N);
+        }
+        leak[W - 1] &= top_mask;
+
+        // The look-ups are independent of each other, unlike in the byte-by-byte loop
+#pragma GCC unroll 8
+        for (int j = 0; j < N; j++) {
+            const uint64_t* entry = lut + ((N - 1 - j) * 256 + idx[j]) * W;
+            for (int w = 0; w < W; w++)
+                leak[w] ^= entry[w];
+        }
+    }
+
+    // Leftover bytes that do not fill a group of N bytes, using the first table only
+    for (; i < n_bytes; i++) {
+        const uint8_t in_byte_plus_leak = y[i] ^ (leak[W - 1] >> msby_shift);
+        const uint64_t* entry = lut + in_byte_plus_leak * W;
+        for (int w = W - 1; w > 0; w--)
+            leak[w] = ((leak[w] << 8) | (leak[w - 1] >> 56)) ^ entry[w];
+        leak[0] = (leak[0] << 8) ^ entry[0];
+        leak[W - 1] &= top_mask;
+    }
+}
+
+/**
+ * @brief Compute the remainder of a dividend with W-word leaks and N-byte slices.
+ *
+ * @note See `gf2_poly_rem_slice`.
+ */
+template <typename T, int W, int N>
+gf2_poly<T> _gf2_poly_rem_slice(u8_cptr_t y,
+                                const int y_size,
+                                const gf2_poly<T>& x,
+                                const uint64_t* x_slice_lut)
+{
+    const int n_leak_bytes = gf2_poly_rem_n_leak_bytes(x.degree());
+    const int n_leading_bytes = y_size - n_leak_bytes;
+    uint64_t leak[W];
+    _gf2_poly_rem_slice_leading<W, N>(
+        y, n_leading_bytes, n_leak_bytes, x_slice_lut, leak);
+    return _gf2_poly_rem_finish<T, W>(y + n_leading_bytes, n_leak_bytes, leak, x);
+}
+
+/**
+ * @brief Compute the remainder "y % x" of GF2 polynomials y and x using slice-by-N LUTs
+ *
+ * Equivalent to `gf2_poly_rem`, but absorbing N input bytes per iteration instead of
+ * one. The byte-by-byte computation forms a serial dependency chain through the leak,
+ * with one LUT look-up per byte. In contrast, the N look-ups of each iteration depend on
+ * the preceding leak only, so they can all be in flight at once. Like
+ * `gf2_poly_rem_batch`, it also holds the leak on plain 64-bit words.
+ *
+ * @tparam T Type whose bits represent the binary polynomial coefficients.
+ * @param y Dividend GF(2) polynomial given by an array of bytes in network byte order.
+ * @param y_size Size of the dividend polynomial y in bytes.
+ * @param x Divisor GF(2) polynomial.
+ * @param x_slice_lut LUT generated by the `build_gf2_poly_rem_slice_lut` function for x.
+ * @return gf2_poly<T> Resulting remainder.
+ */
+template <typename T>
+gf2_poly<T> gf2_poly_rem_slice(u8_cptr_t y,
+                               const int y_size,
+                               const gf2_poly<T>& x,
+                               const std::vector<uint64_t>& x_slice_lut)
+{
+    const int n_leak_bytes = gf2_poly_rem_n_leak_bytes(x.degree());
+    const int n_words = (n_leak_bytes + 7) / 8;
+
+    // Short dividends fit entirely within the leak space and need no LUT processing
+    if (y_size <= n_leak_bytes)
+        return gf2_poly<T>(from_u8_array<T>(y, y_size)) % x;
+
+    const bool slice8 = x_slice_lut.size() == 8 * 256 * static_cast<size_t>(n_words);
+    switch (n_words) {
+    case 1:
+        return slice8 ? _gf2_poly_rem_slice<T, 1, 8>(y, y_size, x, x_slice_lut.data())
+                      : _gf2_poly_rem_slice<T, 1, 4>(y, y_size, x, x_slice_lut.data());
+    case 2:
+        return slice8 ? _gf2_poly_rem_slice<T, 2, 8>(y, y_size, x, x_slice_lut.data())
+                      : _gf2_poly_rem_slice<T, 2, 4>(y, y_size, x, x_slice_lut.data());
+    case 3:
+        return slice8 ? _gf2_poly_rem_slice<T, 3, 8>(y, y_size, x, x_slice_lut.data())
+                      : _gf2_poly_rem_slice<T, 3, 4>(y, y_size, x, x_slice_lut.data());
+    case 4:
+        return slice8 ? _gf2_poly_rem_slice<T, 4, 8>(y, y_size, x, x_slice_lut.data())
+                      : _gf2_poly_rem_slice<T, 4, 4>(y, y_size, x, x_slice_lut.data());
+    default:
+        throw std::runtime_error("Invalid slice-by-N remainder LUT");
+    }
+}
+
+/**
+ * @brief Build the constants used by `gf2_poly_rem_clmul`
+ *
+ * @tparam T Type whose bits represent the binary polynomial coefficients.
+ * @param x Divisor polynomial with degree from 1 to 192.
+ * @return std::array<uint64_t, 6> Remainders of the monomials x^320 and x^256 divided by
+ * the divisor polynomial, in this order, with three 64-bit words each, least significant
+ * word first.
+ */
+template <typename T>
+std::array<uint64_t, 6> build_gf2_poly_rem_clmul_consts(const gf2_poly<T>& x)
+{
+    const int degree = x.degree();
+    if (degree < 1 || degree > 192)
+        throw std::invalid_argument("Unsupported divisor degree for folding");
+
+    // Divisor over 64-bit words
+    uint64_t x_words[4] = { 0 };
+    const int x_bytes = std::min<int>(sizeof(T), (degree / 8) + 1);
+    for (int j = 0; j < x_bytes; j++)
+        x_words[j / 8] |= static_cast<uint64_t>(get_byte(x.get_poly(), j))
+                          << ((j % 8) * 8);
+
+    // Compute the remainders of the monomials x^i divided by the divisor iteratively, one
+    // multiplication by x at a time
+    std::array<uint64_t, 6> consts;
+    uint64_t rem[4] = { 1, 0, 0, 0 };
+    for (int i = 1; i <= 320; i++) {
+        for (int w = 3; w > 0; w--)
+            rem[w] = (rem[w] << 1) | (rem[w - 1] >> 63);
+        rem[0] <<= 1;
+        if ((rem[degree / 64] >> (degree % 64)) & 1)
+            for (int w = 0; w < 4; w++)
+                rem[w] ^= x_words[w];
+        if (i == 256)
+            std::copy(rem, rem + 3, consts.begin() + 3);
+    }
+    std::copy(rem, rem + 3, consts.begin());
+    return consts;
+}
+
+/**
+ * @brief Compute the remainder "y % x" of GF2 polynomials y and x by folding
+ *
+ * Folds the dividend into a 256-bit word congruent to it modulo x using carry-less
+ * multiplications (see `gf2_poly_fold_clmul`), which absorbs 16 input bytes per step,
+ * and then reduces the 256-bit word using the word-sliced LUT.
+ *
+ * @tparam T Type whose bits represent the binary polynomial coefficients.
+ * @param y Dividend GF(2) polynomial given by an array of bytes in network byte order.
+ * @param y_size Size of the dividend polynomial y in bytes.
+ * @param x Divisor GF(2) polynomial with degree up to 192.
+ * @param x_clmul_consts Constants generated by `build_gf2_poly_rem_clmul_consts` for x.
+ * @param x_word_lut LUT generated by the `build_gf2_poly_rem_word_lut` function for x.
+ * @return gf2_poly<T> Resulting remainder.
+ * @note Only call this function if gf2_clmul_supported() returns true.
+ */
+template <typename T>
+gf2_poly<T> gf2_poly_rem_clmul(u8_cptr_t y,
+                               const int y_size,
+                               const gf2_poly<T>& x,
+                               const std::array<uint64_t, 6>& x_clmul_consts,
+                               const std::vector<uint64_t>& x_word_lut)
+{
+    uint64_t acc[4];
+    gf2_poly_fold_clmul(y, y_size, x_clmul_consts.data(), acc);
+
+    // Serialize the folded word in network byte order and reduce it
+    uint8_t acc_bytes[32];
+    for (int i = 0; i < 32; i++)
+        acc_bytes[i] = acc[3 - i / 8] >> (56 - (i % 8) * 8);
+    gf2_poly<T> rem(0);
+    gf2_poly_rem_batch(acc_bytes, 32, 1, x, x_word_lut, &rem);
+    return rem;
+}
+
 } // namespace dvbs2rx
 } // namespace gr
 
@@ -13,6 +13,28 @@
 #include "exclusive_reduce.hh"
 #include "generic.hh"
 #include "simd.hh"
+#include <cstring>
+#include <limits>
+
+// Check whether any of the first "blocks" lanes is non-positive. The lanes are scanned
+// 64 bits at a time, given this runs on every check node until all lanes converge.
+template <typename VALUE, int WIDTH>
+static inline bool any_nonpositive(SIMD<VALUE, WIDTH> v, int blocks)
+{
+    const int STEP = sizeof(uint64_t) / sizeof(VALUE);
+    auto tmp = vcgtz(v);
+    int i = 0;
+    for (; i + STEP <= blocks; i += STEP) {
+        uint64_t word;
+        std::memcpy(&word, tmp.u + i, sizeof(word));
+        if (word != UINT64_MAX)
+            return true;
+    }
+    for (; i < blocks; ++i)
+        if (!tmp.u[i])
+            return true;
+    return false;
+}
 
 template <typename VALUE, int WIDTH>
 struct SelfCorrectedUpdate<SIMD<VALUE, WIDTH>> {
@@ -100,14 +122,7 @@ struct MinSumAlgorithm<SIMD<int8_t, WIDTH>, UPDATE> {
     }
     static TYPE add(TYPE a, TYPE b) { return vqadd(a, b); }
     static TYPE sub(TYPE a, TYPE b) { return vqsub(a, b); }
-    static bool bad(TYPE v, int blocks)
-    {
-        auto tmp = vcgtz(v);
-        for (int i = 0; i < blocks; ++i)
-            if (!tmp.v[i])
-                return true;
-        return false;
-    }
+    static bool bad(TYPE v, int blocks) { return any_nonpositive(v, blocks); }
     static void update(TYPE* a, TYPE b)
     {
         UPDATE::update(a, vmin(vmax(b, vdup<TYPE>(-32)), vdup<TYPE>(31)));
@@ -192,20 +207,106 @@ struct OffsetMinSumAlgorithm<SIMD<int8_t, WIDTH>, UPDATE, FACTOR> {
     }
     static TYPE add(TYPE a, TYPE b) { return vqadd(a, b); }
     static TYPE sub(TYPE a, TYPE b) { return vqsub(a, b); }
-    static bool bad(TYPE v, int blocks)
-    {
-        auto tmp = vcgtz(v);
-        for (int i = 0; i < blocks; ++i)
-            if (!tmp.v[i])
-                return true;
-        return false;
-    }
+    static bool bad(TYPE v, int blocks) { return any_nonpositive(v, blocks); }
     static void update(TYPE* a, TYPE b)
     {
         UPDATE::update(a, vmin(vmax(b, vdup<TYPE>(-32)), vdup<TYPE>(31)));
     }
 };
 
+// Min-sum with the check node update rule set at runtime, for the int8 lanes and the
+// int16 lanes scaled by LLRShift<int16_t>. The message magnitudes are reduced by an
+// offset and then scaled by a normalization factor, given in eighths and applied with
+// shifts on the two minima only. With self-correction, the stored messages whose sign
+// flips between iterations are erased, as in SelfCorrectedUpdate. The defaults match
+// OffsetMinSumAlgorithm with FACTOR 2. The int16 lanes give four times the int8 range
+// to the bit nodes and the stored messages, avoiding the error floor caused by their
+// saturation.
+template <typename TYPE>
+struct TunableMinSumAlgorithm;
+
+template <typename VALUE, int WIDTH>
+struct TunableMinSumAlgorithm<SIMD<VALUE, WIDTH>> {
+    typedef SIMD<VALUE, WIDTH> TYPE;
+    static const int SHIFT = LLRShift<VALUE>::value;
+    static constexpr int MSG_MAX = (sizeof(VALUE) == 1) ? 31 : (128 << SHIFT) - 1;
+    int beta = 1 << SHIFT;
+    int norm = 8;
+    bool self_corrected = false;
+
+    void configure(float offset, float factor, bool self_correct)
+    {
+        beta = std::min<int>(std::max<float>(std::nearbyint(offset * (1 << SHIFT)), 0),
+                             MSG_MAX);
+        norm = std::min<int>(std::max<float>(std::nearbyint(factor * 8), 1), 8);
+        self_corrected = self_correct;
+    }
+    static TYPE zero() { return vzero<TYPE>(); }
+    static TYPE one() { return vdup<TYPE>(1); }
+    static TYPE sign(TYPE a, TYPE b) { return vsign(a, b); }
+    static TYPE eor(TYPE a, TYPE b)
+    {
+        return vreinterpret<TYPE>(veor(vmask(a), vmask(b)));
+    }
+    static TYPE orr(TYPE a, TYPE b)
+    {
+        return vreinterpret<TYPE>(vorr(vmask(a), vmask(b)));
+    }
+    // The second output for the links holding the first minimum, the first otherwise
+    static TYPE other(TYPE mag, TYPE min, TYPE first, TYPE second)
+    {
+        return vreinterpret<TYPE>(vbsl(vceq(mag, min), vmask(second), vmask(first)));
+    }
+    // Remove the missing eighths from a non-negative magnitude, rounding up
+    TYPE scale(TYPE a) const
+    {
+        if (norm == 8)
+            return a;
+        const int cut = 8 - norm;
+        auto mag = vunsigned(a);
+        auto out = mag;
+        for (int k = 1; k <= 3; ++k)
+            if (cut >> (3 - k) & 1)
+                out = vqsub(out, vshr(mag, k));
+        return vsigned(out);
+    }
+    void finalp(TYPE* links, int cnt) const
+    {
+        auto offset = vunsigned(vdup<TYPE>(beta));
+        TYPE mags[cnt];
+        for (int i = 0; i < cnt; ++i)
+            mags[i] = vsigned(vqsub(vunsigned(vqabs(links[i])), offset));
+
+        TYPE mins[2];
+        mins[0] = vmin(mags[0], mags[1]);
+        mins[1] = vmax(mags[0], mags[1]);
+        for (int i = 2; i < cnt; ++i) {
+            mins[1] = vmin(mins[1], vmax(mins[0], mags[i]));
+            mins[0] = vmin(mins[0], mags[i]);
+        }
+        const TYPE first = scale(mins[0]), second = scale(mins[1]);
+
+        TYPE signs = links[0];
+        for (int i = 1; i < cnt; ++i)
+            signs = eor(signs, links[i]);
+
+        const TYPE ones = vdup<TYPE>(std::numeric_limits<VALUE>::max());
+        for (int i = 0; i < cnt; ++i)
+            links[i] = sign(other(mags[i], mins[0], first, second),
+                            orr(eor(signs, links[i]), ones));
+    }
+    static TYPE add(TYPE a, TYPE b) { return vqadd(a, b); }
+    static TYPE sub(TYPE a, TYPE b) { return vqsub(a, b); }
+    static bool bad(TYPE v, int blocks) { return any_nonpositive(v, blocks); }
+    void update(TYPE* a, TYPE b) const
+    {
+        b = vmin(vmax(b, vdup<TYPE>(-MSG_MAX - 1)), vdup<TYPE>(MSG_MAX));
+        if (self_corrected)
+            SelfCorrectedUpdate<TYPE>::update(a, b);
+        else
+            NormalUpdate<TYPE>::update(a, b);
+    }
+};
 
 template <typename VALUE, int WIDTH, typename UPDATE, int FACTOR>
 struct MinSumCAlgorithm<SIMD<VALUE, WIDTH>, UPDATE, FACTOR> {
@@ -289,14 +390,7 @@ struct MinSumCAlgorithm<SIMD<int8_t, WIDTH>, UPDATE, FACTOR> {
     }
     static TYPE add(TYPE a, TYPE b) { return vqadd(a, b); }
     static TYPE sub(TYPE a, TYPE b) { return vqsub(a, b); }
-    static bool bad(TYPE v, int blocks)
-    {
-        auto tmp = vcgtz(v);
-        for (int i = 0; i < blocks; ++i)
-            if (!tmp.v[i])
-                return true;
-        return false;
-    }
+    static bool bad(TYPE v, int blocks) { return any_nonpositive(v, blocks); }
     static void update(TYPE* a, TYPE b)
     {
         UPDATE::update(a, vmin(vmax(b, vdup<TYPE>(-32)), vdup<TYPE>(31)));
@@ -448,6 +448,23 @@ inline SIMD<uint16_t, 16> vqsub(SIMD<uint16_t, 16> a, SIMD<uint16_t, 16> b)
     return tmp;
 }
 
+template <>
+inline SIMD<uint8_t, 32> vshr(SIMD<uint8_t, 32> a, int n)
+{
+    SIMD<uint8_t, 32> tmp;
+    const __m128i count = _mm_cvtsi32_si128(n);
+    tmp.m = _mm256_and_si256(_mm256_srl_epi16(a.m, count), _mm256_set1_epi8(0xff >> n));
+    return tmp;
+}
+
+template <>
+inline SIMD<uint16_t, 16> vshr(SIMD<uint16_t, 16> a, int n)
+{
+    SIMD<uint16_t, 16> tmp;
+    tmp.m = _mm256_srl_epi16(a.m, _mm_cvtsi32_si128(n));
+    return tmp;
+}
+
 template <>
 inline SIMD<float, 8> vabs(SIMD<float, 8> a)
 {
@@ -0,0 +1,450 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2024 Igor Freire.
+ *
+ * This file is part of gr-dvbs2rx.
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#ifndef AVX512_HH
+#define AVX512_HH
+
+#include <immintrin.h>
+
+template <>
+union SIMD<int8_t, 64> {
+    static const int SIZE = 64;
+    typedef int8_t value_type;
+    typedef uint8_t uint_type;
+    __m512i m;
+    value_type v[SIZE];
+    uint_type u[SIZE];
+};
+
+template <>
+union SIMD<int16_t, 32> {
+    static const int SIZE = 32;
+    typedef int16_t value_type;
+    typedef uint16_t uint_type;
+    __m512i m;
+    value_type v[SIZE];
+    uint_type u[SIZE];
+};
+
+template <>
+union SIMD<uint8_t, 64> {
+    static const int SIZE = 64;
+    typedef uint8_t value_type;
+    typedef uint8_t uint_type;
+    __m512i m;
+    value_type v[SIZE];
+    uint_type u[SIZE];
+};
+
+template <>
+union SIMD<uint16_t, 32> {
+    static const int SIZE = 32;
+    typedef uint16_t value_type;
+    typedef uint16_t uint_type;
+    __m512i m;
+    value_type v[SIZE];
+    uint_type u[SIZE];
+};
+
+template <>
+inline SIMD<uint8_t, 64> vreinterpret(SIMD<int8_t, 64> a)
+{
+    SIMD<uint8_t, 64> tmp;
+    tmp.m = a.m;
+    return tmp;
+}
+
+template <>
+inline SIMD<int8_t, 64> vreinterpret(SIMD<uint8_t, 64> a)
+{
+    SIMD<int8_t, 64> tmp;
+    tmp.m = a.m;
+    return tmp;
+}
+
+template <>
+inline SIMD<uint16_t, 32> vreinterpret(SIMD<int16_t, 32> a)
+{
+    SIMD<uint16_t, 32> tmp;
+    tmp.m = a.m;
+    return tmp;
+}
+
+template <>
+inline SIMD<int16_t, 32> vreinterpret(SIMD<uint16_t, 32> a)
+{
+    SIMD<int16_t, 32> tmp;
+    tmp.m = a.m;
+    return tmp;
+}
+
+template <>
+inline SIMD<int8_t, 64> vdup<SIMD<int8_t, 64>>(int8_t a)
+{
+    SIMD<int8_t, 64> tmp;
+    tmp.m = _mm512_set1_epi8(a);
+    return tmp;
+}
+
+template <>
+inline SIMD<int16_t, 32> vdup<SIMD<int16_t, 32>>(int16_t a)
+{
+    SIMD<int16_t, 32> tmp;
+    tmp.m = _mm512_set1_epi16(a);
+    return tmp;
+}
+
+template <>
+inline SIMD<int8_t, 64> vzero()
+{
+    SIMD<int8_t, 64> tmp;
+    tmp.m = _mm512_setzero_si512();
+    return tmp;
+}
+
+template <>
+inline SIMD<int16_t, 32> vzero()
+{
+    SIMD<int16_t, 32> tmp;
+    tmp.m = _mm512_setzero_si512();
+    return tmp;
+}
+
+template <>
+inline SIMD<int8_t, 64> vadd(SIMD<int8_t, 64> a, SIMD<int8_t, 64> b)
+{
+    SIMD<int8_t, 64> tmp;
+    tmp.m = _mm512_add_epi8(a.m, b.m);
+    return tmp;
+}
+
+template <>
+inline SIMD<int16_t, 32> vadd(SIMD<int16_t, 32> a, SIMD<int16_t, 32> b)
+{
+    SIMD<int16_t, 32> tmp;
+    tmp.m = _mm512_add_epi16(a.m, b.m);
+    return tmp;
+}
+
+template <>
+inline SIMD<int8_t, 64> vqadd(SIMD<int8_t, 64> a, SIMD<int8_t, 64> b)
+{
+    SIMD<int8_t, 64> tmp;
+    tmp.m = _mm512_adds_epi8(a.m, b.m);
+    return tmp;
+}
+
+template <>
+inline SIMD<int16_t, 32> vqadd(SIMD<int16_t, 32> a, SIMD<int16_t, 32> b)
+{
+    SIMD<int16_t, 32> tmp;
+    tmp.m = _mm512_adds_epi16(a.m, b.m);
+    return tmp;
+}
+
+template <>
+inline SIMD<int8_t, 64> vsub(SIMD<int8_t, 64> a, SIMD<int8_t, 64> b)
+{
+    SIMD<int8_t, 64> tmp;
+    tmp.m = _mm512_sub_epi8(a.m, b.m);
+    return tmp;
+}
+
+template <>
+inline SIMD<int16_t, 32> vsub(SIMD<int16_t, 32> a, SIMD<int16_t, 32> b)
+{
+    SIMD<int16_t, 32> tmp;
+    tmp.m = _mm512_sub_epi16(a.m, b.m);
+    return tmp;
+}
+
+template <>
+inline SIMD<int8_t, 64> vqsub(SIMD<int8_t, 64> a, SIMD<int8_t, 64> b)
+{
+    SIMD<int8_t, 64> tmp;
+    tmp.m = _mm512_subs_epi8(a.m, b.m);
+    return tmp;
+}
+
+template <>
+inline SIMD<int16_t, 32> vqsub(SIMD<int16_t, 32> a, SIMD<int16_t, 32> b)
+{
+    SIMD<int16_t, 32> tmp;
+    tmp.m = _mm512_subs_epi16(a.m, b.m);
+    return tmp;
+}
+
+template <>
+inline SIMD<uint8_t, 64> vqsub(SIMD<uint8_t, 64> a, SIMD<uint8_t, 64> b)
+{
+    SIMD<uint8_t, 64> tmp;
+    tmp.m = _mm512_subs_epu8(a.m, b.m);
+    return tmp;
+}
+
+template <>
+inline SIMD<uint16_t, 32> vqsub(SIMD<uint16_t, 32> a, SIMD<uint16_t, 32> b)
+{
+    SIMD<uint16_t, 32> tmp;
+    tmp.m = _mm512_subs_epu16(a.m, b.m);
+    return tmp;
+}
+
+template <>
+inline SIMD<uint8_t, 64> vshr(SIMD<uint8_t, 64> a, int n)
+{
+    SIMD<uint8_t, 64> tmp;
+    const __m128i count = _mm_cvtsi32_si128(n);
+    tmp.m = _mm512_and_si512(_mm512_srl_epi16(a.m, count), _mm512_set1_epi8(0xff >> n));
+    return tmp;
+}
+
+template <>
+inline SIMD<uint16_t, 32> vshr(SIMD<uint16_t, 32> a, int n)
+{
+    SIMD<uint16_t, 32> tmp;
+    tmp.m = _mm512_srl_epi16(a.m, _mm_cvtsi32_si128(n));
+    return tmp;
+}
+
+template <>
+inline SIMD<int8_t, 64> vqabs(SIMD<int8_t, 64> a)
+{
+    SIMD<int8_t, 64> tmp;
+    tmp.m = _mm512_abs_epi8(_mm512_max_epi8(a.m, _mm512_set1_epi8(-INT8_MAX)));
+    return tmp;
+}
+
+template <>
+inline SIMD<int16_t, 32> vqabs(SIMD<int16_t, 32> a)
+{
+    SIMD<int16_t, 32> tmp;
+    tmp.m = _mm512_abs_epi16(_mm512_max_epi16(a.m, _mm512_set1_epi16(-INT16_MAX)));
+    return tmp;
+}
+
+// There is no sign instruction on AVX-512. Negate the lanes where b is negative and
+// zero the lanes where b is zero using mask registers instead.
+template <>
+inline SIMD<int8_t, 64> vsign(SIMD<int8_t, 64> a, SIMD<int8_t, 64> b)
+{
+    SIMD<int8_t, 64> tmp;
+    const __m512i zero = _mm512_setzero_si512();
+    tmp.m = _mm512_mask_sub_epi8(a.m, _mm512_movepi8_mask(b.m), zero, a.m);
+    tmp.m = _mm512_maskz_mov_epi8(_mm512_cmpneq_epi8_mask(b.m, zero), tmp.m);
+    return tmp;
+}
+
+template <>
+inline SIMD<int16_t, 32> vsign(SIMD<int16_t, 32> a, SIMD<int16_t, 32> b)
+{
+    SIMD<int16_t, 32> tmp;
+    const __m512i zero = _mm512_setzero_si512();
+    tmp.m = _mm512_mask_sub_epi16(a.m, _mm512_movepi16_mask(b.m), zero, a.m);
+    tmp.m = _mm512_maskz_mov_epi16(_mm512_cmpneq_epi16_mask(b.m, zero), tmp.m);
+    return tmp;
+}
+
+template <>
+inline SIMD<uint8_t, 64> vorr(SIMD<uint8_t, 64> a, SIMD<uint8_t, 64> b)
+{
+    SIMD<uint8_t, 64> tmp;
+    tmp.m = _mm512_or_si512(a.m, b.m);
+    return tmp;
+}
+
+template <>
+inline SIMD<uint16_t, 32> vorr(SIMD<uint16_t, 32> a, SIMD<uint16_t, 32> b)
+{
+    SIMD<uint16_t, 32> tmp;
+    tmp.m = _mm512_or_si512(a.m, b.m);
+    return tmp;
+}
+
+template <>
+inline SIMD<uint8_t, 64> vand(SIMD<uint8_t, 64> a, SIMD<uint8_t, 64> b)
+{
+    SIMD<uint8_t, 64> tmp;
+    tmp.m = _mm512_and_si512(a.m, b.m);
+    return tmp;
+}
+
+template <>
+inline SIMD<uint16_t, 32> vand(SIMD<uint16_t, 32> a, SIMD<uint16_t, 32> b)
+{
+    SIMD<uint16_t, 32> tmp;
+    tmp.m = _mm512_and_si512(a.m, b.m);
+    return tmp;
+}
+
+template <>
+inline SIMD<uint8_t, 64> veor(SIMD<uint8_t, 64> a, SIMD<uint8_t, 64> b)
+{
+    SIMD<uint8_t, 64> tmp;
+    tmp.m = _mm512_xor_si512(a.m, b.m);
+    return tmp;
+}
+
+template <>
+inline SIMD<uint16_t, 32> veor(SIMD<uint16_t, 32> a, SIMD<uint16_t, 32> b)
+{
+    SIMD<uint16_t, 32> tmp;
+    tmp.m = _mm512_xor_si512(a.m, b.m);
+    return tmp;
+}
+
+// Compute "a & ~b" with a ternary logic instruction (truth table 0x30) rather than
+// with _mm512_andnot_si512, whose undefined pass-through operand triggers spurious
+// -Wmaybe-uninitialized warnings on GCC 12.
+template <>
+inline SIMD<uint8_t, 64> vbic(SIMD<uint8_t, 64> a, SIMD<uint8_t, 64> b)
+{
+    SIMD<uint8_t, 64> tmp;
+    tmp.m = _mm512_ternarylogic_epi32(a.m, b.m, b.m, 0x30);
+    return tmp;
+}
+
+template <>
+inline SIMD<uint16_t, 32> vbic(SIMD<uint16_t, 32> a, SIMD<uint16_t, 32> b)
+{
+    SIMD<uint16_t, 32> tmp;
+    tmp.m = _mm512_ternarylogic_epi32(a.m, b.m, b.m, 0x30);
+    return tmp;
+}
+
+template <>
+inline SIMD<uint8_t, 64>
+vbsl(SIMD<uint8_t, 64> a, SIMD<uint8_t, 64> b, SIMD<uint8_t, 64> c)
+{
+    SIMD<uint8_t, 64> tmp;
+    tmp.m = _mm512_ternarylogic_epi32(a.m, b.m, c.m, 0xca);
+    return tmp;
+}
+
+template <>
+inline SIMD<uint16_t, 32>
+vbsl(SIMD<uint16_t, 32> a, SIMD<uint16_t, 32> b, SIMD<uint16_t, 32> c)
+{
+    SIMD<uint16_t, 32> tmp;
+    tmp.m = _mm512_ternarylogic_epi32(a.m, b.m, c.m, 0xca);
+    return tmp;
+}
+
+template <>
+inline SIMD<uint8_t, 64> vceqz(SIMD<int8_t, 64> a)
+{
+    SIMD<uint8_t, 64> tmp;
+    tmp.m = _mm512_movm_epi8(_mm512_cmpeq_epi8_mask(a.m, _mm512_setzero_si512()));
+    return tmp;
+}
+
+template <>
+inline SIMD<uint16_t, 32> vceqz(SIMD<int16_t, 32> a)
+{
+    SIMD<uint16_t, 32> tmp;
+    tmp.m = _mm512_movm_epi16(_mm512_cmpeq_epi16_mask(a.m, _mm512_setzero_si512()));
+    return tmp;
+}
+
+template <>
+inline SIMD<uint8_t, 64> vceq(SIMD<int8_t, 64> a, SIMD<int8_t, 64> b)
+{
+    SIMD<uint8_t, 64> tmp;
+    tmp.m = _mm512_movm_epi8(_mm512_cmpeq_epi8_mask(a.m, b.m));
+    return tmp;
+}
+
+template <>
+inline SIMD<uint16_t, 32> vceq(SIMD<int16_t, 32> a, SIMD<int16_t, 32> b)
+{
+    SIMD<uint16_t, 32> tmp;
+    tmp.m = _mm512_movm_epi16(_mm512_cmpeq_epi16_mask(a.m, b.m));
+    return tmp;
+}
+
+template <>
+inline SIMD<uint8_t, 64> vcgt(SIMD<int8_t, 64> a, SIMD<int8_t, 64> b)
+{
+    SIMD<uint8_t, 64> tmp;
+    tmp.m = _mm512_movm_epi8(_mm512_cmpgt_epi8_mask(a.m, b.m));
+    return tmp;
+}
+
+template <>
+inline SIMD<uint16_t, 32> vcgt(SIMD<int16_t, 32> a, SIMD<int16_t, 32> b)
+{
+    SIMD<uint16_t, 32> tmp;
+    tmp.m = _mm512_movm_epi16(_mm512_cmpgt_epi16_mask(a.m, b.m));
+    return tmp;
+}
+
+template <>
+inline SIMD<uint8_t, 64> vcgtz(SIMD<int8_t, 64> a)
+{
+    SIMD<uint8_t, 64> tmp;
+    tmp.m = _mm512_movm_epi8(_mm512_cmpgt_epi8_mask(a.m, _mm512_setzero_si512()));
+    return tmp;
+}
+
+template <>
+inline SIMD<uint16_t, 32> vcgtz(SIMD<int16_t, 32> a)
+{
+    SIMD<uint16_t, 32> tmp;
+    tmp.m = _mm512_movm_epi16(_mm512_cmpgt_epi16_mask(a.m, _mm512_setzero_si512()));
+    return tmp;
+}
+
+template <>
+inline SIMD<uint8_t, 64> vcltz(SIMD<int8_t, 64> a)
+{
+    SIMD<uint8_t, 64> tmp;
+    tmp.m = _mm512_movm_epi8(_mm512_cmplt_epi8_mask(a.m, _mm512_setzero_si512()));
+    return tmp;
+}
+
+template <>
+inline SIMD<uint16_t, 32> vcltz(SIMD<int16_t, 32> a)
+{
+    SIMD<uint16_t, 32> tmp;
+    tmp.m = _mm512_movm_epi16(_mm512_cmplt_epi16_mask(a.m, _mm512_setzero_si512()));
+    return tmp;
+}
+
+template <>
+inline SIMD<int8_t, 64> vmin(SIMD<int8_t, 64> a, SIMD<int8_t, 64> b)
+{
+    SIMD<int8_t, 64> tmp;
+    tmp.m = _mm512_min_epi8(a.m, b.m);
+    return tmp;
+}
+
+template <>
+inline SIMD<int16_t, 32> vmin(SIMD<int16_t, 32> a, SIMD<int16_t, 32> b)
+{
+    SIMD<int16_t, 32> tmp;
+    tmp.m = _mm512_min_epi16(a.m, b.m);
+    return tmp;
+}
+
+template <>
+inline SIMD<int8_t, 64> vmax(SIMD<int8_t, 64> a, SIMD<int8_t, 64> b)
+{
+    SIMD<int8_t, 64> tmp;
+    tmp.m = _mm512_max_epi8(a.m, b.m);
+    return tmp;
+}
+
+template <>
+inline SIMD<int16_t, 32> vmax(SIMD<int16_t, 32> a, SIMD<int16_t, 32> b)
+{
+    SIMD<int16_t, 32> tmp;
+    tmp.m = _mm512_max_epi16(a.m, b.m);
+    return tmp;
+}
+#endif
@@ -12,11 +12,14 @@
 
 #include "exclusive_reduce.hh"
 #include "ldpc.hh"
+#include "transpose.hh"
+#include <algorithm>
 #include <stdlib.h>
 
 template <typename TYPE, typename ALG>
-class LDPCDecoder
+class FloodingDecoder
 {
+    typedef typename TYPE::value_type code_type;
     void* aligned_buffer;
     TYPE *bnl, *bnv, *cnl, *cnv;
     uint8_t* cnc;
@@ -118,8 +121,65 @@ class LDPCDecoder
             data[i] = bnv[i + R];
     }
 
+    // Same tiled transpositions as the layered decoder, with the 16x16 kernels applied
+    // to full groups of 16 lanes. Only the first "lanes" frames are read from or
+    // written to "code", and the other lanes are zeroed (erased).
+    static const int TILE = 64;
+
+    void serial_to_parallel(TYPE* data, const code_type* code, int lanes)
+    {
+        code_type* words = reinterpret_cast<code_type*>(data);
+        for (int b = 0; b < N; b += TILE) {
+            const int end = std::min(b + TILE, N);
+            int g = 0;
+            for (; g + 16 <= lanes; g += 16) {
+                const code_type* rows[16];
+                for (int r = 0; r < 16; r++)
+                    rows[r] = code + (g + r) * N;
+                int j = b;
+                for (; j + 16 <= end; j += 16)
+                    transpose_rows_to_lanes(
+                        rows, j, words + j * TYPE::SIZE + g, TYPE::SIZE, 0xffff);
+                for (int r = 0; r < 16; r++)
+                    for (int k = j; k < end; k++)
+                        words[k * TYPE::SIZE + g + r] = rows[r][k];
+            }
+            for (int n = g; n < lanes; n++)
+                for (int j = b; j < end; j++)
+                    words[j * TYPE::SIZE + n] = code[(n * N) + j];
+            for (int n = lanes; n < TYPE::SIZE; n++)
+                for (int j = b; j < end; j++)
+                    words[j * TYPE::SIZE + n] = 0;
+        }
+    }
+    void parallel_to_serial(TYPE* data, code_type* code, int lanes)
+    {
+        const code_type* words = reinterpret_cast<const code_type*>(data);
+        for (int b = 0; b < N; b += TILE) {
+            const int end = std::min(b + TILE, N);
+            int g = 0;
+            for (; g + 16 <= lanes; g += 16) {
+                code_type* rows[16];
+                for (int r = 0; r < 16; r++)
+                    rows[r] = code + (g + r) * N;
+                int j = b;
+                for (; j + 16 <= end; j += 16)
+                    transpose_lanes_to_rows(
+                        words + j * TYPE::SIZE + g, TYPE::SIZE, rows, j, 0xffff);
+                for (int r = 0; r < 16; r++)
+                    for (int k = j; k < end; k++)
+                        rows[r][k] = words[k * TYPE::SIZE + g + r];
+            }
+            for (int n = g; n < lanes; n++)
+                for (int j = b; j < end; j++)
+                    code[(n * N) + j] = words[j * TYPE::SIZE + n];
+        }
+    }
+
 public:
-    LDPCDecoder() : initialized(false) {}
+    FloodingDecoder() : initialized(false) {}
+    // Check node update rule, e.g., for setting its runtime parameters
+    ALG& algorithm() { return alg; }
     void init(LDPCInterface* it)
     {
         if (initialized) {
@@ -163,7 +223,44 @@ public:
         update_user(data, parity);
         return trials;
     }
-    ~LDPCDecoder()
+    // Same interface as the layered decoder, with the frames in serial order on "code".
+    int
+    operator()(void* buffer, code_type* code, int trials = 25, int blocks = TYPE::SIZE)
+    {
+        TYPE* data = reinterpret_cast<TYPE*>(buffer);
+        serial_to_parallel(data, code, TYPE::SIZE);
+        trials = (*this)(data, data + K, trials, blocks);
+        parallel_to_serial(data, code, TYPE::SIZE);
+        return trials;
+    }
+    // Decode a stream of frames from "in" to "out", one SIMD batch at a time. The
+    // flooding schedule cannot recycle lanes, as all bit nodes are updated together.
+    // Hence, the converged frames of a batch share the batch's remaining trials, and the
+    // frames failing to converge get a negative count. Returns the number of iterations.
+    int stream(void* buffer,
+               const code_type* in,
+               code_type* out,
+               int frames,
+               int trials,
+               int* counts)
+    {
+        TYPE* data = reinterpret_cast<TYPE*>(buffer);
+        int iterations = 0;
+        for (int f = 0; f < frames; f += TYPE::SIZE) {
+            const int lanes = std::min(frames - f, (int)TYPE::SIZE);
+            serial_to_parallel(data, in + f * N, lanes);
+            const int count = (*this)(data, data + K, trials, lanes);
+            iterations += trials - std::max(count, 0);
+            parallel_to_serial(data, out + f * N, lanes);
+            TYPE acc = alg.one();
+            for (int i = 0; i < R; ++i)
+                acc = vmin(acc, cnv[i]);
+            for (int n = 0; n < lanes; ++n)
+                counts[f + n] = (acc.v[n] > 0) ? std::max(count, 0) : -1;
+        }
+        return iterations;
+    }
+    ~FloodingDecoder()
     {
         if (initialized) {
             free(aligned_buffer);
@@ -0,0 +1,104 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2024 Igor Freire.
+ *
+ * This file is part of gr-dvbs2rx.
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#ifndef HARD_DECISION_HH
+#define HARD_DECISION_HH
+
+#include <cstdint>
+#include <cstring>
+
+#if defined(__AVX512BW__) || defined(__AVX2__) || defined(__SSSE3__)
+#include <immintrin.h>
+#elif defined(__ARM_NEON__) || defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+/*
+ * Hard decisions on LLRs packed into bytes with the MSB first, i.e., the sign of
+ * llr[8 * i + k] goes to bit 7 - k of out[i], set when the LLR is negative.
+ *
+ * The x86 versions reverse the order of each group of 8 LLRs with a byte shuffle so
+ * that a single movemask yields the packed bytes already in MSB-first order. The NEON
+ * version weights the sign masks by the bit values and sums them pairwise. Otherwise,
+ * each group of 8 LLRs is packed with a multiplication gathering the sign bits.
+ *
+ * The implementation depends on the instruction set flags of the including translation
+ * unit (one per LDPC backend), so it is kept in an anonymous namespace to give each
+ * backend its own copy.
+ */
+
+namespace {
+
+namespace hard_decision_detail {
+inline uint8_t pack8(const int8_t* llr)
+{
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+    uint64_t x;
+    memcpy(&x, llr, 8);
+    x = (x >> 7) & 0x0101010101010101; // sign of llr[k] on bit 8 * k
+    return (x * 0x8040201008040201) >> 56;
+#else
+    uint8_t byte = 0;
+    for (int k = 0; k < 8; k++)
+        byte |= uint8_t(llr[k] < 0) << (7 - k);
+    return byte;
+#endif
+}
+} // namespace hard_decision_detail
+
+inline void pack_hard_decisions(const int8_t* llr, uint8_t* out, int n_bytes)
+{
+    int i = 0;
+#if defined(__AVX512BW__)
+    const __m512i rev = _mm512_set4_epi64(
+        0x08090a0b0c0d0e0f, 0x0001020304050607, 0x08090a0b0c0d0e0f, 0x0001020304050607);
+    for (; i + 8 <= n_bytes; i += 8) {
+        const __m512i x = _mm512_loadu_si512(llr + 8 * i);
+        const uint64_t mask = _mm512_movepi8_mask(_mm512_shuffle_epi8(x, rev));
+        memcpy(out + i, &mask, 8);
+    }
+#elif defined(__AVX2__)
+    const __m256i rev = _mm256_setr_epi8(7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10,
+                                         9, 8, 7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12,
+                                         11, 10, 9, 8);
+    for (; i + 4 <= n_bytes; i += 4) {
+        const __m256i x =
+            _mm256_loadu_si256(reinterpret_cast<const __m256i*>(llr + 8 * i));
+        const uint32_t mask = _mm256_movemask_epi8(_mm256_shuffle_epi8(x, rev));
+        memcpy(out + i, &mask, 4);
+    }
+#elif defined(__SSSE3__)
+    const __m128i rev =
+        _mm_setr_epi8(7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8);
+    for (; i + 2 <= n_bytes; i += 2) {
+        const __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(llr + 8 * i));
+        const uint16_t mask = _mm_movemask_epi8(_mm_shuffle_epi8(x, rev));
+        memcpy(out + i, &mask, 2);
+    }
+#elif defined(__ARM_NEON__) || defined(__ARM_NEON)
+    static const uint8_t weights[16] = { 128, 64, 32, 16, 8, 4, 2, 1,
+                                         128, 64, 32, 16, 8, 4, 2, 1 };
+    const uint8x16_t w = vld1q_u8(weights);
+    for (; i + 2 <= n_bytes; i += 2) {
+        const int8x16_t x = vld1q_s8(llr + 8 * i);
+        const uint8x16_t bits = vandq_u8(vreinterpretq_u8_s8(vshrq_n_s8(x, 7)), w);
+        uint8x8_t sum = vpadd_u8(vget_low_u8(bits), vget_high_u8(bits));
+        sum = vpadd_u8(sum, sum);
+        sum = vpadd_u8(sum, sum);
+        out[i] = vget_lane_u8(sum, 0);
+        out[i + 1] = vget_lane_u8(sum, 1);
+    }
+#endif
+    for (; i < n_bytes; i++)
+        out[i] = hard_decision_detail::pack8(llr + 8 * i);
+}
+
+} // namespace
+
+#endif
@@ -11,15 +11,21 @@
 #define LAYERED_DECODER_HH
 
 #include "ldpc.hh"
+#include "ldpc_structure.hh"
+#include "transpose.hh"
+#include <algorithm>
+#include <memory>
 #include <stdlib.h>
 
 template <typename TYPE, typename ALG>
 class LDPCDecoder
 {
-    typedef typename TYPE::value_type code_type;
+    typedef typename TYPE::value_type value_type;
+    typedef int8_t code_type;
     TYPE *bnl, *pty;
-    uint16_t* pos;
-    uint8_t* cnc;
+    std::shared_ptr<const LDPCStructure> code_struct;
+    const uint16_t* pos;
+    const uint8_t* cnc;
     ALG alg;
     int M, N, K, R, q, CNL, LT;
     bool initialized;
@@ -47,13 +53,19 @@ class LDPCDecoder
         }
         return false;
     }
-    void update(TYPE* data, TYPE* parity)
+    // With FRESH, the lanes cleared on "keep" start over with zeroed bit node links,
+    // as required after loading new frames into them.
+    template <bool FRESH = false>
+    void update(TYPE* data, TYPE* parity, TYPE keep = TYPE())
     {
         TYPE* bl = bnl;
         for (int i = 0; i < q; ++i) {
             int cnt = cnc[i];
             for (int j = 0; j < M; ++j) {
                 int deg = cnt + 2 - !(i | j);
+                if (FRESH)
+                    for (int d = 0; d < deg; ++d)
+                        bl[d] = vreinterpret<TYPE>(vand(vmask(bl[d]), vmask(keep)));
                 TYPE inp[deg], out[deg];
                 for (int c = 0; c < cnt; ++c)
                     inp[c] = out[c] = alg.sub(data[pos[CNL * (M * i + j) + c]], bl[c]);
@@ -78,93 +90,248 @@ class LDPCDecoder
         }
     }
 
-    void serial_to_parallel(TYPE* data, code_type* code)
+    // Per-lane convergence check for lane recycling. Returns the minimum check node
+    // sign on each lane, which is positive only on the lanes whose frames converged.
+    // Stops early once none of the "live" lanes can converge anymore.
+    TYPE check(TYPE* data, TYPE* parity, const int* live)
     {
-        for (int n = 0; n < TYPE::SIZE; n++) {
-            for (int j = 0; j < N; j++) {
-                reinterpret_cast<code_type*>(data + j)[n] = code[(n * N) + j];
+        TYPE acc = alg.one();
+        for (int i = 0; i < q; ++i) {
+            int cnt = cnc[i];
+            for (int j = 0; j < M; ++j) {
+                TYPE cnv = alg.sign(alg.one(), parity[M * i + j]);
+                if (i)
+                    cnv = alg.sign(cnv, parity[M * (i - 1) + j]);
+                else if (j)
+                    cnv = alg.sign(cnv, parity[j + (q - 1) * M - 1]);
+                for (int c = 0; c < cnt; ++c)
+                    cnv = alg.sign(cnv, data[pos[CNL * (M * i + j) + c]]);
+                acc = vmin(acc, cnv);
             }
+            bool any = false;
+            for (int n = 0; n < TYPE::SIZE && !any; ++n)
+                any = live[n] >= 0 && acc.v[n] > 0;
+            if (!any)
+                break;
         }
+        return acc;
     }
 
-    void parallel_to_serial(TYPE* data, code_type* code)
+    // Move whole frames between the serial buffers and the lanes selected on "sel"
+    // (one bit per lane), where lane n holds frame lane_frame[n]. The codeword bits go
+    // through "data" in natural order, and the parity bits are then moved between
+    // "data + K" and the check node order used by "pty". The transpositions run over
+    // tiles of codeword bits so that the SIMD words being written or read stay in
+    // cache. Within each tile, the groups of 16 lanes with at least MIN_GROUP frames
+    // to move use the 16x16 transposition kernels, and the others go lane by lane.
+    // Lanes wider than the int8 LLRs always go lane by lane, scaling the LLRs by
+    // LLRShift on the way in and saturating them back to int8 on the way out.
+    static const bool WIDE = sizeof(value_type) > sizeof(code_type);
+    static const int SHIFT = LLRShift<value_type>::value;
+    static const int TILE = 64;
+    static const int MIN_GROUP = 4;
+    static const uint64_t ALL_LANES =
+        (TYPE::SIZE < 64) ? (uint64_t(1) << (TYPE::SIZE % 64)) - 1 : ~uint64_t(0);
+
+    static code_type narrow(value_type v)
     {
-        for (int n = 0; n < TYPE::SIZE; n++) {
-            for (int j = 0; j < N; j++) {
-                code[(n * N) + j] = reinterpret_cast<code_type*>(data + j)[n];
+        if (!WIDE)
+            return v;
+        return std::min(std::max(v >> SHIFT, -127), 127);
+    }
+
+    void load_lanes(TYPE* data, const code_type* in, const int* lane_frame, uint64_t sel)
+    {
+        value_type* words = reinterpret_cast<value_type*>(data);
+        const code_type* rows[TYPE::SIZE];
+        TYPE fresh;
+        for (int n = 0; n < TYPE::SIZE; ++n) {
+            rows[n] = (sel >> n & 1) ? in + lane_frame[n] * N : nullptr;
+            fresh.v[n] = (sel >> n & 1) ? -1 : 0;
+        }
+        for (int b = 0; b < N; b += TILE) {
+            const int end = std::min(b + TILE, N);
+            for (int g = 0; g < TYPE::SIZE; g += 16) {
+                const uint16_t mask = sel >> g;
+                if (!mask)
+                    continue;
+                int j = b;
+                if (!WIDE && __builtin_popcount(mask) >= MIN_GROUP) {
+                    const code_type* grp[16];
+                    const code_type* any = rows[g + __builtin_ctz(mask)];
+                    for (int r = 0; r < 16; ++r)
+                        grp[r] = rows[g + r] ? rows[g + r] : any;
+                    for (; j + 16 <= end; j += 16)
+                        transpose_rows_to_lanes(
+                            grp,
+                            j,
+                            reinterpret_cast<code_type*>(words + j * TYPE::SIZE + g),
+                            TYPE::SIZE,
+                            mask);
+                }
+                for (int r = 0; r < 16; ++r)
+                    if (mask >> r & 1)
+                        for (int k = j; k < end; ++k)
+                            words[k * TYPE::SIZE + g + r] = rows[g + r][k] * (1 << SHIFT);
+            }
+        }
+        const auto keep = vmask(fresh);
+        for (int i = 0; i < q; ++i) {
+            for (int j = 0; j < M; ++j) {
+                auto src = vand(vmask(data[K + q * j + i]), keep);
+                auto dst = vbic(vmask(pty[M * i + j]), keep);
+                pty[M * i + j] = vreinterpret<TYPE>(vorr(src, dst));
+            }
+        }
+    }
+    void store_lanes(TYPE* data, code_type* out, const int* lane_frame, uint64_t sel)
+    {
+        value_type* words = reinterpret_cast<value_type*>(data);
+        code_type* rows[TYPE::SIZE];
+        for (int n = 0; n < TYPE::SIZE; ++n)
+            rows[n] = (sel >> n & 1) ? out + lane_frame[n] * N : nullptr;
+        for (int i = 0; i < q; ++i)
+            for (int j = 0; j < M; ++j)
+                data[K + q * j + i] = pty[M * i + j];
+        for (int b = 0; b < N; b += TILE) {
+            const int end = std::min(b + TILE, N);
+            for (int g = 0; g < TYPE::SIZE; g += 16) {
+                const uint16_t mask = sel >> g;
+                if (!mask)
+                    continue;
+                int j = b;
+                if (!WIDE && __builtin_popcount(mask) >= MIN_GROUP) {
+                    for (; j + 16 <= end; j += 16)
+                        transpose_lanes_to_rows(
+                            reinterpret_cast<code_type*>(words + j * TYPE::SIZE + g),
+                            TYPE::SIZE,
+                            rows + g,
+                            j,
+                            mask);
+                }
+                for (int r = 0; r < 16; ++r)
+                    if (mask >> r & 1)
+                        for (int k = j; k < end; ++k)
+                            rows[g + r][k] = narrow(words[k * TYPE::SIZE + g + r]);
             }
         }
     }
 
 public:
     LDPCDecoder() : initialized(false) {}
+    // Check node update rule, e.g., for setting its runtime parameters
+    ALG& algorithm() { return alg; }
     void init(LDPCInterface* it)
     {
         if (initialized) {
             free(bnl);
             free(pty);
-            delete[] cnc;
-            delete[] pos;
         }
         initialized = true;
-        LDPCInterface* ldpc = it->clone();
-        N = ldpc->code_len();
-        K = ldpc->data_len();
-        M = ldpc->group_len();
-        R = N - K;
-        q = R / M;
-        CNL = ldpc->links_max_cn() - 2;
-        pos = new uint16_t[R * CNL];
-        cnc = new uint8_t[R];
-        for (int i = 0; i < R; ++i)
-            cnc[i] = 0;
-        ldpc->first_bit();
-        for (int j = 0; j < K; ++j) {
-            int* acc_pos = ldpc->acc_pos();
-            int bit_deg = ldpc->bit_deg();
-            for (int n = 0; n < bit_deg; ++n) {
-                int i = acc_pos[n];
-                pos[CNL * i + cnc[i]++] = j;
-            }
-            ldpc->next_bit();
-        }
-        LT = ldpc->links_total();
-        delete ldpc;
+        code_struct = ldpc_structure(it);
+        N = code_struct->N;
+        K = code_struct->K;
+        M = code_struct->M;
+        R = code_struct->R;
+        q = code_struct->q;
+        CNL = code_struct->CNL;
+        LT = code_struct->LT;
+        pos = code_struct->pos.data();
+        cnc = code_struct->cnc.data();
         bnl = reinterpret_cast<TYPE*>(aligned_alloc(sizeof(TYPE), sizeof(TYPE) * LT));
         pty = reinterpret_cast<TYPE*>(aligned_alloc(sizeof(TYPE), sizeof(TYPE) * R));
-        uint16_t* tmp = new uint16_t[R * CNL];
-        for (int i = 0; i < q; ++i)
-            for (int j = 0; j < M; ++j)
-                for (int c = 0; c < CNL; ++c)
-                    tmp[CNL * (M * i + j) + c] = pos[CNL * (q * j + i) + c];
-        delete[] pos;
-        pos = tmp;
     }
-    int operator()(void* buffer, code_type* code, int trials = 25)
+    // Only the first "blocks" lanes gate the convergence check. The remaining lanes
+    // may carry padding when decoding a partially filled batch.
+    int
+    operator()(void* buffer, code_type* code, int trials = 25, int blocks = TYPE::SIZE)
     {
-        const int blocks = TYPE::SIZE;
         TYPE* data = reinterpret_cast<TYPE*>(buffer);
-        TYPE* parity = data + K;
-        serial_to_parallel(data, code);
+        int lane_frame[TYPE::SIZE];
+        for (int n = 0; n < TYPE::SIZE; ++n)
+            lane_frame[n] = n;
+        load_lanes(data, code, lane_frame, ALL_LANES);
         reset();
-        for (int i = 0; i < q; ++i)
-            for (int j = 0; j < M; ++j)
-                pty[M * i + j] = parity[q * j + i];
         while (bad(data, pty, blocks) && --trials >= 0)
             update(data, pty);
-        for (int i = 0; i < q; ++i)
-            for (int j = 0; j < M; ++j)
-                parity[q * j + i] = pty[M * i + j];
-        parallel_to_serial(data, code);
+        store_lanes(data, code, lane_frame, ALL_LANES);
         return trials;
     }
+    // Decode a stream of "frames" frames with lane recycling. The frames are read from
+    // "in" and the decoded LLRs written to "out", which can be the same buffer. Each
+    // frame leaves its lane as soon as it converges or runs out of trials, and the
+    // freed lanes are refilled with the next frames in the stream. Hence, the frames
+    // only iterate as much as they need instead of waiting for the worst one in a
+    // batch. The remaining trials of each frame are saved on "counts" (negative if
+    // failed). Returns the number of iterations of the whole SIMD word.
+    int stream(void* buffer,
+               const code_type* in,
+               code_type* out,
+               int frames,
+               int trials,
+               int* counts)
+    {
+        TYPE* data = reinterpret_cast<TYPE*>(buffer);
+        TYPE* parity = pty;
+        int lane_frame[TYPE::SIZE], lane_trials[TYPE::SIZE];
+        int next = 0, active = 0, iterations = 0;
+        for (int n = 0; n < TYPE::SIZE; ++n)
+            lane_frame[n] = -1;
+        for (int i = 0; i < K; ++i)
+            data[i] = alg.zero();
+        for (int i = 0; i < R; ++i)
+            parity[i] = alg.zero();
+        reset();
+        while (true) {
+            TYPE keep = vdup<TYPE>(-1);
+            uint64_t sel = 0;
+            for (int n = 0; n < TYPE::SIZE && next < frames; ++n) {
+                if (lane_frame[n] < 0) {
+                    lane_frame[n] = next++;
+                    lane_trials[n] = trials;
+                    keep.v[n] = 0;
+                    sel |= uint64_t(1) << n;
+                }
+            }
+            if (sel) {
+                load_lanes(data, in, lane_frame, sel);
+                active += __builtin_popcountll(sel);
+            }
+            if (!active)
+                break;
+            TYPE acc = check(data, parity, lane_frame);
+            uint64_t done = 0;
+            for (int n = 0; n < TYPE::SIZE; ++n) {
+                if (lane_frame[n] < 0)
+                    continue;
+                bool good = acc.v[n] > 0;
+                if (good || --lane_trials[n] < 0) {
+                    counts[lane_frame[n]] = good ? lane_trials[n] : -1;
+                    done |= uint64_t(1) << n;
+                }
+            }
+            if (done) {
+                store_lanes(data, out, lane_frame, done);
+                for (int n = 0; n < TYPE::SIZE; ++n)
+                    if (done >> n & 1)
+                        lane_frame[n] = -1;
+                active -= __builtin_popcountll(done);
+            }
+            if (active) {
+                if (sel)
+                    update<true>(data, parity, keep);
+                else
+                    update(data, parity);
+                ++iterations;
+            }
+        }
+        return iterations;
+    }
     ~LDPCDecoder()
     {
         if (initialized) {
             free(bnl);
             free(pty);
-            delete[] cnc;
-            delete[] pos;
         }
     }
 };
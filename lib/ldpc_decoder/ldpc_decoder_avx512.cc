@@ -0,0 +1,23 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2022 Igor Freire.
+ *
+ * This file is part of gr-dvbs2rx.
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#include "algorithms.hh"
+#include "flooding_decoder.hh"
+#include "hard_decision.hh"
+#include "layered_decoder.hh"
+#include "ldpc_decoder_isa.hh"
+
+namespace ldpc_avx512 {
+
+typedef SIMD<int8_t, 64> simd_type;
+typedef SIMD<int16_t, 32> simd_int16_type;
+
+#include "ldpc_decoder_impl.inc"
+
+} // namespace ldpc_avx512
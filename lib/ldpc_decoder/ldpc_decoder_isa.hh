@@ -0,0 +1,83 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2024 Igor Freire.
+ *
+ * This file is part of gr-dvbs2rx.
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#ifndef LDPC_DECODER_ISA_HH
+#define LDPC_DECODER_ISA_HH
+
+#include "ldpc.hh"
+#include <cstdint>
+
+/*
+ * Entry points of the LDPC decoder implementations, one namespace per instruction set.
+ * Each implementation is compiled separately with its own target flags, and the
+ * caller selects one at runtime based on the CPU features. All namespaces share the
+ * declarations on ldpc_decoder_api.inc and the definitions on ldpc_decoder_impl.inc,
+ * so the implementations only differ in their SIMD types.
+ *
+ * - ldpc_dec_create: allocates a decoder instance for the given code and check node
+ *   update rule.
+ * - ldpc_dec_destroy: releases a decoder instance.
+ * - ldpc_dec_decode: decodes a batch of SIMD-size frames in place on the "code" buffer,
+ *   using "buffer" as the working memory. The first "blocks" frames gate the early
+ *   termination. Returns the remaining number of trials, or a negative value when the
+ *   decoding fails to converge within the given number of trials.
+ * - ldpc_dec_decode_stream: decodes any number of frames with lane recycling, i.e., each
+ *   frame leaves its SIMD lane once it converges, and the next frame takes the lane.
+ *   The frames are read directly from "in" and the decoded LLRs written to "out",
+ *   which may point to the same buffer. Saves the remaining trials of each frame on
+ *   "counts" (negative if failed) and returns the number of decoder iterations.
+ *
+ * The functions above use the layered schedule. The "_flooding" variants have the same
+ * semantics but use the flooding schedule instead, which updates all check nodes and
+ * then all bit nodes on each iteration. The flooding decoder cannot recycle lanes, so
+ * its stream decoding runs one SIMD batch at a time.
+ *
+ * The "_int16" variants use the layered schedule on 16-bit lanes, i.e., half as many
+ * frames per SIMD word, with the LLRs scaled up by LLRShift<int16_t> internally. They
+ * take and return int8 LLRs like the others and use a "buffer" of the same size in
+ * bytes, but a batch decoded by ldpc_dec_decode_int16 holds half as many frames. The
+ * extra precision avoids the saturation of the int8 messages at low SNR.
+ *
+ * - ldpc_dec_pack: packs the hard decisions on "8 * bytes" decoded LLRs into "bytes"
+ *   bytes with the MSB first, using the instruction set's byte shuffles and sign masks.
+ */
+
+/*
+ * Check node update rule shared by all decoders. The magnitudes of the check node
+ * messages are reduced by "offset" (in LLR units) and then scaled by "factor", which is
+ * rounded to eighths. With "self_corrected", the messages whose sign flips between
+ * iterations are erased. The defaults give the offset min-sum algorithm.
+ */
+struct ldpc_min_sum_t {
+    float offset = 1.0f;
+    float factor = 1.0f;
+    bool self_corrected = false;
+};
+
+namespace ldpc_neon {
+#include "ldpc_decoder_api.inc"
+} // namespace ldpc_neon
+
+namespace ldpc_avx512 {
+#include "ldpc_decoder_api.inc"
+} // namespace ldpc_avx512
+
+namespace ldpc_avx2 {
+#include "ldpc_decoder_api.inc"
+} // namespace ldpc_avx2
+
+namespace ldpc_sse41 {
+#include "ldpc_decoder_api.inc"
+} // namespace ldpc_sse41
+
+namespace ldpc_generic {
+#include "ldpc_decoder_api.inc"
+} // namespace ldpc_generic
+
+#endif
@@ -8,23 +8,16 @@
  */
 
 #include "algorithms.hh"
+#include "flooding_decoder.hh"
+#include "hard_decision.hh"
 #include "layered_decoder.hh"
-
-#define FACTOR 2
+#include "ldpc_decoder_isa.hh"
 
 namespace ldpc_sse41 {
 
 typedef SIMD<int8_t, 16> simd_type;
-typedef NormalUpdate<simd_type> update_type;
-typedef OffsetMinSumAlgorithm<simd_type, update_type, FACTOR> algorithm_type;
-
-LDPCDecoder<simd_type, algorithm_type> LdpcDecoder;
-
-void ldpc_dec_init(LDPCInterface* it) { LdpcDecoder.init(it); }
+typedef SIMD<int16_t, 8> simd_int16_type;
 
-int ldpc_dec_decode(void* buffer, int8_t* code, int trials)
-{
-    return LdpcDecoder(buffer, code, trials);
-}
+#include "ldpc_decoder_impl.inc"
 
 } // namespace ldpc_sse41
@@ -0,0 +1,102 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2024 Igor Freire.
+ *
+ * This file is part of gr-dvbs2rx.
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#ifndef LDPC_STRUCTURE_HH
+#define LDPC_STRUCTURE_HH
+
+#include "ldpc.hh"
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <typeindex>
+#include <typeinfo>
+#include <vector>
+
+/*
+ * Parity-check structure used by the layered decoder, namely the bit node positions
+ * connected to each check node ("pos") and the check node degrees ("cnc"), with the
+ * check nodes already in the decoder's processing order.
+ *
+ * The structure depends only on the code table, not on the SIMD type or algorithm.
+ * Hence, it is built once per code and shared read-only by every decoder instance in
+ * the process, regardless of the instruction set.
+ */
+struct LDPCStructure {
+    int M, N, K, R, q, CNL, LT;
+    std::vector<uint16_t> pos;
+    std::vector<uint8_t> cnc;
+
+    explicit LDPCStructure(LDPCInterface* it)
+    {
+        LDPCInterface* ldpc = it->clone();
+        N = ldpc->code_len();
+        K = ldpc->data_len();
+        M = ldpc->group_len();
+        R = N - K;
+        q = R / M;
+        CNL = ldpc->links_max_cn() - 2;
+        LT = ldpc->links_total();
+        std::vector<uint16_t> tmp(R * CNL);
+        cnc.assign(R, 0);
+        ldpc->first_bit();
+        for (int j = 0; j < K; ++j) {
+            int* acc_pos = ldpc->acc_pos();
+            int bit_deg = ldpc->bit_deg();
+            for (int n = 0; n < bit_deg; ++n) {
+                int i = acc_pos[n];
+                tmp[CNL * i + cnc[i]++] = j;
+            }
+            ldpc->next_bit();
+        }
+        delete ldpc;
+        pos.resize(R * CNL);
+        for (int i = 0; i < q; ++i)
+            for (int j = 0; j < M; ++j)
+                for (int c = 0; c < CNL; ++c)
+                    pos[CNL * (M * i + j) + c] = tmp[CNL * (q * j + i) + c];
+    }
+};
+
+/*
+ * Get the parity-check structure of a given code from the process-wide cache, building
+ * it on the first request. Each LDPC<TABLE> type identifies one code.
+ */
+inline std::shared_ptr<const LDPCStructure> ldpc_structure(LDPCInterface* it)
+{
+    static std::mutex mutex;
+    static std::map<std::type_index, std::shared_ptr<const LDPCStructure>> cache;
+    std::lock_guard<std::mutex> lock(mutex);
+    auto& entry = cache[std::type_index(typeid(*it))];
+    if (!entry)
+        entry = std::make_shared<const LDPCStructure>(it);
+    return entry;
+}
+
+/*
+ * Count the parity checks left unsatisfied by the hard decisions on the LLRs of a
+ * codeword in natural order, where a negative LLR stands for a one bit. Check node r
+ * covers the parity bits r and r - 1 (accumulator) and the data bits on "pos", which
+ * lists the check nodes in the decoder's processing order.
+ */
+inline int ldpc_unsatisfied_checks(const LDPCStructure& code, const int8_t* llr)
+{
+    const int8_t* parity = llr + code.K;
+    int count = 0;
+    for (int r = 0; r < code.R; ++r) {
+        const uint16_t* pos = &code.pos[code.CNL * (code.M * (r % code.q) + r / code.q)];
+        bool bit = (parity[r] < 0) ^ (r > 0 && parity[r - 1] < 0);
+        for (int c = 0; c < code.cnc[r]; ++c)
+            bit ^= llr[pos[c]] < 0;
+        count += bit;
+    }
+    return count;
+}
+
+#endif
@@ -438,6 +438,22 @@ inline SIMD<uint16_t, 8> vqsub(SIMD<uint16_t, 8> a, SIMD<uint16_t, 8> b)
     return tmp;
 }
 
+template <>
+inline SIMD<uint8_t, 16> vshr(SIMD<uint8_t, 16> a, int n)
+{
+    SIMD<uint8_t, 16> tmp;
+    tmp.m = vshlq_u8(a.m, vdupq_n_s8(-n));
+    return tmp;
+}
+
+template <>
+inline SIMD<uint16_t, 8> vshr(SIMD<uint16_t, 8> a, int n)
+{
+    SIMD<uint16_t, 8> tmp;
+    tmp.m = vshlq_u16(a.m, vdupq_n_s16(-n));
+    return tmp;
+}
+
 template <>
 inline SIMD<float, 4> vabs(SIMD<float, 4> a)
 {
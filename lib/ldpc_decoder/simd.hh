@@ -53,6 +53,19 @@ union SIMD<int16_t, WIDTH> {
     uint_type u[SIZE];
 };
 
+// Fixed-point scale of the LLRs held on the lanes of a given value type, as a left shift
+// relative to the int8 LLRs exchanged with the decoder's caller. The int16 lanes keep
+// two fractional bits, so the decoder messages lose less precision.
+template <typename VALUE>
+struct LLRShift {
+    static const int value = 0;
+};
+
+template <>
+struct LLRShift<int16_t> {
+    static const int value = 2;
+};
+
 template <int WIDTH>
 union SIMD<int32_t, WIDTH> {
     static const int SIZE = WIDTH;
@@ -1121,6 +1134,24 @@ static inline SIMD<uint16_t, WIDTH> vqsub(SIMD<uint16_t, WIDTH> a,
     return tmp;
 }
 
+template <int WIDTH>
+static inline SIMD<uint8_t, WIDTH> vshr(SIMD<uint8_t, WIDTH> a, int n)
+{
+    SIMD<uint8_t, WIDTH> tmp;
+    for (int i = 0; i < WIDTH; ++i)
+        tmp.v[i] = a.v[i] >> n;
+    return tmp;
+}
+
+template <int WIDTH>
+static inline SIMD<uint16_t, WIDTH> vshr(SIMD<uint16_t, WIDTH> a, int n)
+{
+    SIMD<uint16_t, WIDTH> tmp;
+    for (int i = 0; i < WIDTH; ++i)
+        tmp.v[i] = a.v[i] >> n;
+    return tmp;
+}
+
 template <int WIDTH>
 static inline SIMD<float, WIDTH> vsign(SIMD<float, WIDTH> a, SIMD<float, WIDTH> b)
 {
@@ -1175,6 +1206,10 @@ static inline SIMD<int64_t, WIDTH> vsign(SIMD<int64_t, WIDTH> a, SIMD<int64_t, W
     return tmp;
 }
 
+#ifdef __AVX512BW__
+#include "avx512.hh"
+#endif
+
 #ifdef __AVX2__
 #include "avx2.hh"
 #else
@@ -448,6 +448,23 @@ inline SIMD<uint16_t, 8> vqsub(SIMD<uint16_t, 8> a, SIMD<uint16_t, 8> b)
     return tmp;
 }
 
+template <>
+inline SIMD<uint8_t, 16> vshr(SIMD<uint8_t, 16> a, int n)
+{
+    SIMD<uint8_t, 16> tmp;
+    const __m128i count = _mm_cvtsi32_si128(n);
+    tmp.m = _mm_and_si128(_mm_srl_epi16(a.m, count), _mm_set1_epi8(0xff >> n));
+    return tmp;
+}
+
+template <>
+inline SIMD<uint16_t, 8> vshr(SIMD<uint16_t, 8> a, int n)
+{
+    SIMD<uint16_t, 8> tmp;
+    tmp.m = _mm_srl_epi16(a.m, _mm_cvtsi32_si128(n));
+    return tmp;
+}
+
 template <>
 inline SIMD<float, 4> vabs(SIMD<float, 4> a)
 {
@@ -0,0 +1,249 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2024 Igor Freire.
+ *
+ * This file is part of gr-dvbs2rx.
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#ifndef TRANSPOSE_HH
+#define TRANSPOSE_HH
+
+#include <cstdint>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__ARM_NEON__) || defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+/*
+ * Byte transpositions between frames stored in serial order ("rows") and the
+ * interleaved layout used by the SIMD decoders, where the i-th SIMD word holds the
+ * i-th LLR of every frame, one frame per lane.
+ *
+ * The kernels move a block of 16 LLRs of 16 frames at a time, i.e., 16 consecutive
+ * lanes of 16 consecutive SIMD words, with a 16x16 byte transposition built from
+ * unpack (SSE2) or zip (NEON) shuffles. The "mask" selects which of the 16 lanes/rows
+ * are actually written, so that the lanes of other frames are preserved. Platforms
+ * without 128-bit shuffles fall back to scalar copies.
+ *
+ * Each LDPC backend includes this header on a translation unit compiled with different
+ * instruction set flags, so the helpers are kept in an anonymous namespace. Otherwise,
+ * the linker would keep a single copy of each, possibly with instructions that the CPU
+ * running the other backends does not support.
+ */
+
+namespace {
+
+#if defined(__SSE2__)
+namespace transpose_detail {
+// 16x16 byte transposition in four stages of 8-, 16-, 32- and 64-bit interleaving
+inline void transpose16x16(__m128i x[16])
+{
+    __m128i t[16];
+    for (int i = 0; i < 8; i++) {
+        t[2 * i] = _mm_unpacklo_epi8(x[2 * i], x[2 * i + 1]);
+        t[2 * i + 1] = _mm_unpackhi_epi8(x[2 * i], x[2 * i + 1]);
+    }
+    for (int i = 0; i < 4; i++) {
+        for (int j = 0; j < 2; j++) {
+            x[4 * i + j] = _mm_unpacklo_epi16(t[4 * i + j], t[4 * i + j + 2]);
+            x[4 * i + j + 2] = _mm_unpackhi_epi16(t[4 * i + j], t[4 * i + j + 2]);
+        }
+    }
+    for (int i = 0; i < 2; i++) {
+        for (int j = 0; j < 4; j++) {
+            t[8 * i + j] = _mm_unpacklo_epi32(x[8 * i + j], x[8 * i + j + 4]);
+            t[8 * i + j + 4] = _mm_unpackhi_epi32(x[8 * i + j], x[8 * i + j + 4]);
+        }
+    }
+    for (int j = 0; j < 8; j++) {
+        x[j] = _mm_unpacklo_epi64(t[j], t[j + 8]);
+        x[j + 8] = _mm_unpackhi_epi64(t[j], t[j + 8]);
+    }
+    // Undo the bit-reversed output order left by the interleaving stages
+    static const int order[16] = { 0, 8, 4, 12, 2, 10, 6, 14, 1, 9, 5, 13, 3, 11, 7, 15 };
+    for (int i = 0; i < 16; i++)
+        t[order[i]] = x[i];
+    for (int i = 0; i < 16; i++)
+        x[i] = t[i];
+}
+
+inline __m128i lane_mask(uint16_t mask)
+{
+    const __m128i bits =
+        _mm_setr_epi8(1, 2, 4, 8, 16, 32, 64, -128, 1, 2, 4, 8, 16, 32, 64, -128);
+    const __m128i m = _mm_setr_epi8(mask & 0xff,
+                                    mask & 0xff,
+                                    mask & 0xff,
+                                    mask & 0xff,
+                                    mask & 0xff,
+                                    mask & 0xff,
+                                    mask & 0xff,
+                                    mask & 0xff,
+                                    mask >> 8,
+                                    mask >> 8,
+                                    mask >> 8,
+                                    mask >> 8,
+                                    mask >> 8,
+                                    mask >> 8,
+                                    mask >> 8,
+                                    mask >> 8);
+    return _mm_cmpeq_epi8(_mm_and_si128(m, bits), bits);
+}
+} // namespace transpose_detail
+#elif defined(__ARM_NEON__) || defined(__ARM_NEON)
+namespace transpose_detail {
+inline void zip(uint8x16_t& a, uint8x16_t& b)
+{
+    uint8x16x2_t r = vzipq_u8(a, b);
+    a = r.val[0];
+    b = r.val[1];
+}
+inline void zip(uint16x8_t& a, uint16x8_t& b)
+{
+    uint16x8x2_t r = vzipq_u16(a, b);
+    a = r.val[0];
+    b = r.val[1];
+}
+inline void zip(uint32x4_t& a, uint32x4_t& b)
+{
+    uint32x4x2_t r = vzipq_u32(a, b);
+    a = r.val[0];
+    b = r.val[1];
+}
+inline void zip64(uint8x16_t& a, uint8x16_t& b)
+{
+    uint64x2_t x = vreinterpretq_u64_u8(a), y = vreinterpretq_u64_u8(b);
+    a = vreinterpretq_u8_u64(vcombine_u64(vget_low_u64(x), vget_low_u64(y)));
+    b = vreinterpretq_u8_u64(vcombine_u64(vget_high_u64(x), vget_high_u64(y)));
+}
+
+// Same interleaving stages as the SSE2 version
+inline void transpose16x16(uint8x16_t x[16])
+{
+    for (int i = 0; i < 8; i++)
+        zip(x[2 * i], x[2 * i + 1]);
+    for (int i = 0; i < 4; i++) {
+        for (int j = 0; j < 2; j++) {
+            uint16x8_t a = vreinterpretq_u16_u8(x[4 * i + j]);
+            uint16x8_t b = vreinterpretq_u16_u8(x[4 * i + j + 2]);
+            zip(a, b);
+            x[4 * i + j] = vreinterpretq_u8_u16(a);
+            x[4 * i + j + 2] = vreinterpretq_u8_u16(b);
+        }
+    }
+    for (int i = 0; i < 2; i++) {
+        for (int j = 0; j < 4; j++) {
+            uint32x4_t a = vreinterpretq_u32_u8(x[8 * i + j]);
+            uint32x4_t b = vreinterpretq_u32_u8(x[8 * i + j + 4]);
+            zip(a, b);
+            x[8 * i + j] = vreinterpretq_u8_u32(a);
+            x[8 * i + j + 4] = vreinterpretq_u8_u32(b);
+        }
+    }
+    for (int j = 0; j < 8; j++)
+        zip64(x[j], x[j + 8]);
+    static const int order[16] = { 0, 8, 4, 12, 2, 10, 6, 14, 1, 9, 5, 13, 3, 11, 7, 15 };
+    uint8x16_t t[16];
+    for (int i = 0; i < 16; i++)
+        t[order[i]] = x[i];
+    for (int i = 0; i < 16; i++)
+        x[i] = t[i];
+}
+
+inline uint8x16_t lane_mask(uint16_t mask)
+{
+    static const uint8_t bits[16] = { 1, 2, 4, 8, 16, 32, 64, 128,
+                                      1, 2, 4, 8, 16, 32, 64, 128 };
+    const uint8x16_t b = vld1q_u8(bits);
+    const uint8x16_t m =
+        vcombine_u8(vdup_n_u8(mask & 0xff), vdup_n_u8((mask >> 8) & 0xff));
+    return vtstq_u8(m, b);
+}
+} // namespace transpose_detail
+#endif
+
+/*
+ * Copy the 16 LLRs starting at rows[r] + col into lane r of 16 consecutive SIMD words
+ * starting at "dst", spaced by "stride" bytes, for the rows r selected on "mask". The
+ * unselected rows must still point to readable memory.
+ */
+inline void transpose_rows_to_lanes(
+    const int8_t* const rows[16], int col, int8_t* dst, int stride, uint16_t mask)
+{
+#if defined(__SSE2__)
+    using namespace transpose_detail;
+    __m128i x[16];
+    for (int r = 0; r < 16; r++)
+        x[r] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(rows[r] + col));
+    transpose16x16(x);
+    if (mask == 0xffff) {
+        for (int c = 0; c < 16; c++)
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + c * stride), x[c]);
+    } else {
+        const __m128i m = lane_mask(mask);
+        for (int c = 0; c < 16; c++) {
+            __m128i* p = reinterpret_cast<__m128i*>(dst + c * stride);
+            const __m128i old = _mm_loadu_si128(p);
+            _mm_storeu_si128(
+                p, _mm_or_si128(_mm_and_si128(m, x[c]), _mm_andnot_si128(m, old)));
+        }
+    }
+#elif defined(__ARM_NEON__) || defined(__ARM_NEON)
+    using namespace transpose_detail;
+    uint8x16_t x[16];
+    for (int r = 0; r < 16; r++)
+        x[r] = vld1q_u8(reinterpret_cast<const uint8_t*>(rows[r] + col));
+    transpose16x16(x);
+    const uint8x16_t m = lane_mask(mask);
+    for (int c = 0; c < 16; c++) {
+        uint8_t* p = reinterpret_cast<uint8_t*>(dst + c * stride);
+        vst1q_u8(p, vbslq_u8(m, x[c], vld1q_u8(p)));
+    }
+#else
+    for (int r = 0; r < 16; r++)
+        if (mask & (1 << r))
+            for (int c = 0; c < 16; c++)
+                dst[c * stride + r] = rows[r][col + c];
+#endif
+}
+
+/*
+ * Copy lane r of 16 consecutive SIMD words starting at "src", spaced by "stride" bytes,
+ * into the 16 LLRs starting at rows[r] + col, for the rows r selected on "mask".
+ */
+inline void transpose_lanes_to_rows(
+    const int8_t* src, int stride, int8_t* const rows[16], int col, uint16_t mask)
+{
+#if defined(__SSE2__)
+    using namespace transpose_detail;
+    __m128i x[16];
+    for (int c = 0; c < 16; c++)
+        x[c] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + c * stride));
+    transpose16x16(x);
+    for (int r = 0; r < 16; r++)
+        if (mask & (1 << r))
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(rows[r] + col), x[r]);
+#elif defined(__ARM_NEON__) || defined(__ARM_NEON)
+    using namespace transpose_detail;
+    uint8x16_t x[16];
+    for (int c = 0; c < 16; c++)
+        x[c] = vld1q_u8(reinterpret_cast<const uint8_t*>(src + c * stride));
+    transpose16x16(x);
+    for (int r = 0; r < 16; r++)
+        if (mask & (1 << r))
+            vst1q_u8(reinterpret_cast<uint8_t*>(rows[r] + col), x[r]);
+#else
+    for (int r = 0; r < 16; r++)
+        if (mask & (1 << r))
+            for (int c = 0; c < 16; c++)
+                rows[r][col + c] = src[c * stride + r];
+#endif
+}
+
+} // namespace
+
+#endif
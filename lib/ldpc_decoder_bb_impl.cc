@@ -14,12 +14,15 @@
 #include "cpu_features_macros.h"
 #include "debug_level.h"
 #include "fec_params.h"
+#include "ldpc_decoder/ldpc_decoder_isa.hh"
 #include "ldpc_decoder_bb_impl.h"
 #include <gnuradio/io_signature.h>
 #include <gnuradio/logger.h>
 #include <gnuradio/pdu.h>
 #include <boost/format.hpp>
+#include <algorithm>
 #include <cmath>
+#include <cstring>
 
 #ifdef CPU_FEATURES_ARCH_ARM
 #include "cpuinfo_arm.h"
@@ -31,186 +34,141 @@ using namespace cpu_features;
 using namespace cpu_features;
 #endif
 
-namespace ldpc_neon {
-void ldpc_dec_init(LDPCInterface* it);
-int ldpc_dec_decode(void* buffer, int8_t* code, int trials);
-} // namespace ldpc_neon
-
-namespace ldpc_avx2 {
-void ldpc_dec_init(LDPCInterface* it);
-int ldpc_dec_decode(void* buffer, int8_t* code, int trials);
-} // namespace ldpc_avx2
-
-namespace ldpc_sse41 {
-void ldpc_dec_init(LDPCInterface* it);
-int ldpc_dec_decode(void* buffer, int8_t* code, int trials);
-} // namespace ldpc_sse41
-
-namespace ldpc_generic {
-void ldpc_dec_init(LDPCInterface* it);
-int ldpc_dec_decode(void* buffer, int8_t* code, int trials);
-} // namespace ldpc_generic
-
 namespace gr {
 namespace dvbs2rx {
 
-ldpc_decoder_bb::sptr ldpc_decoder_bb::make(dvb_standard_t standard,
-                                            dvb_framesize_t framesize,
-                                            dvb_code_rate_t rate,
-                                            dvb_constellation_t constellation,
-                                            dvb_outputmode_t outputmode,
-                                            dvb_infomode_t infomode,
-                                            int max_trials,
-                                            int debug_level)
-{
-    return gnuradio::get_initial_sptr(new ldpc_decoder_bb_impl(standard,
-                                                               framesize,
-                                                               rate,
-                                                               constellation,
-                                                               outputmode,
-                                                               infomode,
-                                                               max_trials,
-                                                               debug_level));
-}
+/**
+ * @brief Code rate of each DVB-S2 MODCOD from 1 to 28.
+ */
+static const dvb_code_rate_t dvbs2_modcod_rate[28] = {
+    C1_4, C1_3, C2_5, C1_2, C3_5, C2_3, C3_4, C4_5, C5_6, C8_9, C9_10, // QPSK
+    C3_5, C2_3, C3_4, C5_6, C8_9, C9_10,                               // 8PSK
+    C2_3, C3_4, C4_5, C5_6, C8_9, C9_10,                               // 16APSK
+    C3_4, C4_5, C5_6, C8_9, C9_10                                      // 32APSK
+};
 
-/*
- * The private constructor
+/**
+ * @brief Instantiate the LDPC code table of a given code.
+ *
+ * @param standard DVB standard.
+ * @param framesize FECFRAME size.
+ * @param rate Code rate.
+ * @return LDPCInterface* LDPC code, or nullptr if the code is not supported.
  */
-ldpc_decoder_bb_impl::ldpc_decoder_bb_impl(dvb_standard_t standard,
-                                           dvb_framesize_t framesize,
-                                           dvb_code_rate_t rate,
-                                           dvb_constellation_t constellation,
-                                           dvb_outputmode_t outputmode,
-                                           dvb_infomode_t infomode,
-                                           int max_trials,
-                                           int debug_level)
-    : gr::block("ldpc_decoder_bb",
-                gr::io_signature::make(1, 1, sizeof(int8_t)),
-                gr::io_signature::make(1, 1, sizeof(unsigned char))),
-      d_debug_level(debug_level),
-      d_output_mode(outputmode),
-      d_frame_cnt(0),
-      d_batch_cnt(0),
-      d_total_trials(0),
-      d_max_trials(max_trials)
+static LDPCInterface*
+new_ldpc_code(dvb_standard_t standard, dvb_framesize_t framesize, dvb_code_rate_t rate)
 {
-    fec_info_t fec_info;
-    get_fec_info(standard, framesize, rate, fec_info);
-    d_kldpc = fec_info.ldpc.k;
-    d_nldpc = fec_info.ldpc.n;
-    d_kldpc_bytes = d_kldpc / 8;
-    d_nldpc_bytes = d_nldpc / 8;
-
+    LDPCInterface* ldpc = nullptr;
     if (framesize == FECFRAME_NORMAL) {
         switch (rate) {
         case C1_4:
-            d_ldpc = new LDPC<DVB_S2_TABLE_B1>();
+            ldpc = new LDPC<DVB_S2_TABLE_B1>();
             break;
         case C1_3:
-            d_ldpc = new LDPC<DVB_S2_TABLE_B2>();
+            ldpc = new LDPC<DVB_S2_TABLE_B2>();
             break;
         case C2_5:
-            d_ldpc = new LDPC<DVB_S2_TABLE_B3>();
+            ldpc = new LDPC<DVB_S2_TABLE_B3>();
             break;
         case C1_2:
-            d_ldpc = new LDPC<DVB_S2_TABLE_B4>();
+            ldpc = new LDPC<DVB_S2_TABLE_B4>();
             break;
         case C3_5:
-            d_ldpc = new LDPC<DVB_S2_TABLE_B5>();
+            ldpc = new LDPC<DVB_S2_TABLE_B5>();
             break;
         case C2_3:
             if (standard == STANDARD_DVBS2) {
-                d_ldpc = new LDPC<DVB_S2_TABLE_B6>();
+                ldpc = new LDPC<DVB_S2_TABLE_B6>();
             } else {
-                d_ldpc = new LDPC<DVB_T2_TABLE_A3>();
+                ldpc = new LDPC<DVB_T2_TABLE_A3>();
             }
             break;
         case C3_4:
-            d_ldpc = new LDPC<DVB_S2_TABLE_B7>();
+            ldpc = new LDPC<DVB_S2_TABLE_B7>();
             break;
         case C4_5:
-            d_ldpc = new LDPC<DVB_S2_TABLE_B8>();
+            ldpc = new LDPC<DVB_S2_TABLE_B8>();
             break;
         case C5_6:
-            d_ldpc = new LDPC<DVB_S2_TABLE_B9>();
+            ldpc = new LDPC<DVB_S2_TABLE_B9>();
             break;
         case C8_9:
-            d_ldpc = new LDPC<DVB_S2_TABLE_B10>();
+            ldpc = new LDPC<DVB_S2_TABLE_B10>();
             break;
         case C9_10:
-            d_ldpc = new LDPC<DVB_S2_TABLE_B11>();
+            ldpc = new LDPC<DVB_S2_TABLE_B11>();
             break;
         case C2_9_VLSNR:
-            d_ldpc = new LDPC<DVB_S2X_TABLE_B1>();
+            ldpc = new LDPC<DVB_S2X_TABLE_B1>();
             break;
         case C13_45:
-            d_ldpc = new LDPC<DVB_S2X_TABLE_B2>();
+            ldpc = new LDPC<DVB_S2X_TABLE_B2>();
             break;
         case C9_20:
-            d_ldpc = new LDPC<DVB_S2X_TABLE_B3>();
+            ldpc = new LDPC<DVB_S2X_TABLE_B3>();
             break;
         case C90_180:
-            d_ldpc = new LDPC<DVB_S2X_TABLE_B11>();
+            ldpc = new LDPC<DVB_S2X_TABLE_B11>();
             break;
         case C96_180:
-            d_ldpc = new LDPC<DVB_S2X_TABLE_B12>();
+            ldpc = new LDPC<DVB_S2X_TABLE_B12>();
             break;
         case C11_20:
-            d_ldpc = new LDPC<DVB_S2X_TABLE_B4>();
+            ldpc = new LDPC<DVB_S2X_TABLE_B4>();
             break;
         case C100_180:
-            d_ldpc = new LDPC<DVB_S2X_TABLE_B13>();
+            ldpc = new LDPC<DVB_S2X_TABLE_B13>();
             break;
         case C104_180:
-            d_ldpc = new LDPC<DVB_S2X_TABLE_B14>();
+            ldpc = new LDPC<DVB_S2X_TABLE_B14>();
             break;
         case C26_45:
-            d_ldpc = new LDPC<DVB_S2X_TABLE_B5>();
+            ldpc = new LDPC<DVB_S2X_TABLE_B5>();
             break;
         case C18_30:
-            d_ldpc = new LDPC<DVB_S2X_TABLE_B22>();
+            ldpc = new LDPC<DVB_S2X_TABLE_B22>();
             break;
         case C28_45:
-            d_ldpc = new LDPC<DVB_S2X_TABLE_B6>();
+            ldpc = new LDPC<DVB_S2X_TABLE_B6>();
             break;
         case C23_36:
-            d_ldpc = new LDPC<DVB_S2X_TABLE_B7>();
+            ldpc = new LDPC<DVB_S2X_TABLE_B7>();
             break;
         case C116_180:
-            d_ldpc = new LDPC<DVB_S2X_TABLE_B15>();
+            ldpc = new LDPC<DVB_S2X_TABLE_B15>();
             break;
         case C20_30:
-            d_ldpc = new LDPC<DVB_S2X_TABLE_B23>();
+            ldpc = new LDPC<DVB_S2X_TABLE_B23>();
             break;
         case C124_180:
-            d_ldpc = new LDPC<DVB_S2X_TABLE_B16>();
+            ldpc = new LDPC<DVB_S2X_TABLE_B16>();
             break;
         case C25_36:
-            d_ldpc = new LDPC<DVB_S2X_TABLE_B8>();
+            ldpc = new LDPC<DVB_S2X_TABLE_B8>();
             break;
         case C128_180:
-            d_ldpc = new LDPC<DVB_S2X_TABLE_B17>();
+            ldpc = new LDPC<DVB_S2X_TABLE_B17>();
             break;
         case C13_18:
-            d_ldpc = new LDPC<DVB_S2X_TABLE_B9>();
+            ldpc = new LDPC<DVB_S2X_TABLE_B9>();
             break;
         case C132_180:
-            d_ldpc = new LDPC<DVB_S2X_TABLE_B18>();
+            ldpc = new LDPC<DVB_S2X_TABLE_B18>();
             break;
         case C22_30:
-            d_ldpc = new LDPC<DVB_S2X_TABLE_B24>();
+            ldpc = new LDPC<DVB_S2X_TABLE_B24>();
             break;
         case C135_180:
-            d_ldpc = new LDPC<DVB_S2X_TABLE_B19>();
+            ldpc = new LDPC<DVB_S2X_TABLE_B19>();
             break;
         case C140_180:
-            d_ldpc = new LDPC<DVB_S2X_TABLE_B20>();
+            ldpc = new LDPC<DVB_S2X_TABLE_B20>();
             break;
         case C7_9:
-            d_ldpc = new LDPC<DVB_S2X_TABLE_B10>();
+            ldpc = new LDPC<DVB_S2X_TABLE_B10>();
             break;
         case C154_180:
-            d_ldpc = new LDPC<DVB_S2X_TABLE_B21>();
+            ldpc = new LDPC<DVB_S2X_TABLE_B21>();
             break;
         default:
             break;
@@ -218,74 +176,74 @@ ldpc_decoder_bb_impl::ldpc_decoder_bb_impl(dvb_standard_t standard,
     } else if (framesize == FECFRAME_SHORT) {
         switch (rate) {
         case C1_4:
-            d_ldpc = new LDPC<DVB_S2_TABLE_C1>();
+            ldpc = new LDPC<DVB_S2_TABLE_C1>();
             break;
         case C1_3:
-            d_ldpc = new LDPC<DVB_S2_TABLE_C2>();
+            ldpc = new LDPC<DVB_S2_TABLE_C2>();
             break;
         case C2_5:
-            d_ldpc = new LDPC<DVB_S2_TABLE_C3>();
+            ldpc = new LDPC<DVB_S2_TABLE_C3>();
             break;
         case C1_2:
-            d_ldpc = new LDPC<DVB_S2_TABLE_C4>();
+            ldpc = new LDPC<DVB_S2_TABLE_C4>();
             break;
         case C3_5:
             if (standard == STANDARD_DVBS2) {
-                d_ldpc = new LDPC<DVB_S2_TABLE_C5>();
+                ldpc = new LDPC<DVB_S2_TABLE_C5>();
             } else {
-                d_ldpc = new LDPC<DVB_T2_TABLE_B3>();
+                ldpc = new LDPC<DVB_T2_TABLE_B3>();
             }
             break;
         case C2_3:
-            d_ldpc = new LDPC<DVB_S2_TABLE_C6>();
+            ldpc = new LDPC<DVB_S2_TABLE_C6>();
             break;
         case C3_4:
-            d_ldpc = new LDPC<DVB_S2_TABLE_C7>();
+            ldpc = new LDPC<DVB_S2_TABLE_C7>();
             break;
         case C4_5:
-            d_ldpc = new LDPC<DVB_S2_TABLE_C8>();
+            ldpc = new LDPC<DVB_S2_TABLE_C8>();
             break;
         case C5_6:
-            d_ldpc = new LDPC<DVB_S2_TABLE_C9>();
+            ldpc = new LDPC<DVB_S2_TABLE_C9>();
             break;
         case C8_9:
-            d_ldpc = new LDPC<DVB_S2_TABLE_C10>();
+            ldpc = new LDPC<DVB_S2_TABLE_C10>();
             break;
         case C11_45:
-            d_ldpc = new LDPC<DVB_S2X_TABLE_C1>();
+            ldpc = new LDPC<DVB_S2X_TABLE_C1>();
             break;
         case C4_15:
-            d_ldpc = new LDPC<DVB_S2X_TABLE_C2>();
+            ldpc = new LDPC<DVB_S2X_TABLE_C2>();
             break;
         case C14_45:
-            d_ldpc = new LDPC<DVB_S2X_TABLE_C3>();
+            ldpc = new LDPC<DVB_S2X_TABLE_C3>();
             break;
         case C7_15:
-            d_ldpc = new LDPC<DVB_S2X_TABLE_C4>();
+            ldpc = new LDPC<DVB_S2X_TABLE_C4>();
             break;
         case C8_15:
-            d_ldpc = new LDPC<DVB_S2X_TABLE_C5>();
+            ldpc = new LDPC<DVB_S2X_TABLE_C5>();
             break;
         case C26_45:
-            d_ldpc = new LDPC<DVB_S2X_TABLE_C6>();
+            ldpc = new LDPC<DVB_S2X_TABLE_C6>();
             break;
         case C32_45:
-            d_ldpc = new LDPC<DVB_S2X_TABLE_C7>();
+            ldpc = new LDPC<DVB_S2X_TABLE_C7>();
             break;
         case C1_5_VLSNR_SF2:
-            d_ldpc = new LDPC<DVB_S2_TABLE_C1>();
+            ldpc = new LDPC<DVB_S2_TABLE_C1>();
             break;
         case C11_45_VLSNR_SF2:
-            d_ldpc = new LDPC<DVB_S2X_TABLE_C1>();
+            ldpc = new LDPC<DVB_S2X_TABLE_C1>();
             break;
         case C1_5_VLSNR:
-            d_ldpc = new LDPC<DVB_S2_TABLE_C1>();
+            ldpc = new LDPC<DVB_S2_TABLE_C1>();
             break;
         case C4_15_VLSNR:
-            d_ldpc = new LDPC<DVB_S2X_TABLE_C2>();
+            ldpc = new LDPC<DVB_S2X_TABLE_C2>();
             break;
         case C1_3_VLSNR:
-            d_ldpc = new LDPC<DVB_S2_TABLE_C2>();
+            ldpc = new LDPC<DVB_S2_TABLE_C2>();
             break;
         default:
             break;
@@ -293,20 +251,237 @@ ldpc_decoder_bb_impl::ldpc_decoder_bb_impl(dvb_standard_t standard,
     } else {
         switch (rate) {
         case C1_5_MEDIUM:
-            d_ldpc = new LDPC<DVB_S2X_TABLE_C8>();
+            ldpc = new LDPC<DVB_S2X_TABLE_C8>();
             break;
         case C11_45_MEDIUM:
-            d_ldpc = new LDPC<DVB_S2X_TABLE_C9>();
+            ldpc = new LDPC<DVB_S2X_TABLE_C9>();
             break;
         case C1_3_MEDIUM:
-            d_ldpc = new LDPC<DVB_S2X_TABLE_C10>();
+            ldpc = new LDPC<DVB_S2X_TABLE_C10>();
             break;
         default:
             break;
         }
     }
+    return ldpc;
+}
+
+ldpc_decoder_bb::sptr ldpc_decoder_bb::make(dvb_standard_t standard,
+                                            dvb_framesize_t framesize,
+                                            dvb_code_rate_t rate,
+                                            dvb_constellation_t constellation,
+                                            dvb_outputmode_t outputmode,
+                                            dvb_infomode_t infomode,
+                                            int max_trials,
+                                            int debug_level,
+                                            int batch_timeout_ms,
+                                            int num_threads,
+                                            bool acm_vcm,
+                                            uint64_t pls_filter_lo,
+                                            uint64_t pls_filter_hi,
+                                            dvb_ldpc_schedule_t schedule,
+                                            int llr_pdu_period,
+                                            int llr_pdu_frames,
+                                            dvb_ldpc_precision_t precision,
+                                            dvb_ldpc_algorithm_t algorithm,
+                                            float offset,
+                                            float factor,
+                                            int min_trials,
+                                            int trials_backlog,
+                                            bool frame_stats)
+{
+    return gnuradio::get_initial_sptr(new ldpc_decoder_bb_impl(standard,
+                                                               framesize,
+                                                               rate,
+                                                               constellation,
+                                                               outputmode,
+                                                               infomode,
+                                                               max_trials,
+                                                               debug_level,
+                                                               batch_timeout_ms,
+                                                               num_threads,
+                                                               acm_vcm,
+                                                               pls_filter_lo,
+                                                               pls_filter_hi,
+                                                               schedule,
+                                                               llr_pdu_period,
+                                                               llr_pdu_frames,
+                                                               precision,
+                                                               algorithm,
+                                                               offset,
+                                                               factor,
+                                                               min_trials,
+                                                               trials_backlog,
+                                                               frame_stats));
+}
+
+const int LLR_PDU_POOL_SIZE = 4; // LLR PDU vectors that can be in flight at once
+const int DEFAULT_TRIALS = 25;
+
+// Select the decoder entry points of a given instruction set for the chosen schedule.
+// Only the layered schedule has a 16-bit implementation.
+#define SET_LDPC_DECODER(isa)                                         \
+    do {                                                              \
+        if (schedule == LDPC_FLOODING) {                              \
+            create_decoder[0] = &isa::ldpc_dec_create_flooding;       \
+            destroy_decoder[0] = &isa::ldpc_dec_destroy_flooding;     \
+            decode_stream[0] = &isa::ldpc_dec_decode_stream_flooding; \
+        } else {                                                      \
+            create_decoder[0] = &isa::ldpc_dec_create;                \
+            destroy_decoder[0] = &isa::ldpc_dec_destroy;              \
+            decode_stream[0] = &isa::ldpc_dec_decode_stream;          \
+        }                                                             \
+        create_decoder[1] = &isa::ldpc_dec_create_int16;              \
+        destroy_decoder[1] = &isa::ldpc_dec_destroy_int16;            \
+        decode_stream[1] = &isa::ldpc_dec_decode_stream_int16;        \
+        pack_hard = &isa::ldpc_dec_pack;                              \
+    } while (0)
+
+// Whether the automatic precision uses 16 bits for a given code rate. The 16-bit
+// decoder costs about 1.5x the decoding time, so it is reserved for the codes with
+// rates up to 2/5, which operate at the lowest SNRs and are the most prone to the
+// saturation of the 8-bit messages.
+static bool auto_int16(dvb_code_rate_t rate)
+{
+    switch (rate) {
+    case C1_4:
+    case C1_3:
+    case C2_5:
+    case C13_45:
+    case C11_45:
+    case C4_15:
+    case C14_45:
+    case C2_9_VLSNR:
+    case C1_5_MEDIUM:
+    case C11_45_MEDIUM:
+    case C1_3_MEDIUM:
+    case C1_5_VLSNR_SF2:
+    case C11_45_VLSNR_SF2:
+    case C1_5_VLSNR:
+    case C4_15_VLSNR:
+    case C1_3_VLSNR:
+        return true;
+    default:
+        return false;
+    }
+}
+
+/*
+ * The private constructor
+ */
+ldpc_decoder_bb_impl::ldpc_decoder_bb_impl(dvb_standard_t standard,
+                                           dvb_framesize_t framesize,
+                                           dvb_code_rate_t rate,
+                                           dvb_constellation_t constellation,
+                                           dvb_outputmode_t outputmode,
+                                           dvb_infomode_t infomode,
+                                           int max_trials,
+                                           int debug_level,
+                                           int batch_timeout_ms,
+                                           int num_threads,
+                                           bool acm_vcm,
+                                           uint64_t pls_filter_lo,
+                                           uint64_t pls_filter_hi,
+                                           dvb_ldpc_schedule_t schedule,
+                                           int llr_pdu_period,
+                                           int llr_pdu_frames,
+                                           dvb_ldpc_precision_t precision,
+                                           dvb_ldpc_algorithm_t algorithm,
+                                           float offset,
+                                           float factor,
+                                           int min_trials,
+                                           int trials_backlog,
+                                           bool frame_stats)
+    : gr::block("ldpc_decoder_bb",
+                gr::io_signature::make(1, 1, sizeof(int8_t)),
+                gr::io_signature::make(1, 1, sizeof(unsigned char))),
+      d_debug_level(debug_level),
+      d_output_mode(outputmode),
+      d_frame_cnt(0),
+      d_batch_cnt(0),
+      d_total_trials(0),
+      d_max_trials((max_trials == 0) ? DEFAULT_TRIALS : max_trials),
+      d_min_trials(min_trials),
+      d_trials_backlog(trials_backlog),
+      d_trials_cap(d_max_trials),
+      d_precision((schedule == LDPC_FLOODING) ? LDPC_PRECISION_INT8 : precision),
+      d_llr_pdu_period(llr_pdu_period),
+      d_llr_pdu_frames(llr_pdu_frames),
+      d_skipped_llr_pdus(0),
+      d_frame_stats(frame_stats),
+      d_batch_timeout_ms(batch_timeout_ms),
+      d_partial_pending(false),
+      d_timer_armed(false),
+      d_timer_stop(false),
+      d_acm_vcm(acm_vcm),
+      d_n_active_codes(0),
+      d_dropped_llrs(0)
+{
+    if (schedule == LDPC_FLOODING && precision == LDPC_PRECISION_INT16)
+        throw std::runtime_error("The flooding schedule only supports 8-bit precision");
+    if (d_max_trials < 1)
+        throw std::runtime_error("The maximum number of LDPC iterations must be >= 1");
+    if (min_trials < 0)
+        throw std::runtime_error("The minimum LDPC iteration cap must be >= 0");
+    if (trials_backlog < 0)
+        throw std::runtime_error("The LDPC iteration cap backlog must be >= 0");
+    if (offset < 0)
+        throw std::runtime_error("The min-sum offset must be non-negative");
+    if (factor <= 0 || factor > 1)
+        throw std::runtime_error("The min-sum normalization factor must be in (0, 1]");
+
+    // The normalized min-sum has no offset, and the other rules no normalization
+    if (algorithm == LDPC_NORMALIZED_MIN_SUM) {
+        d_min_sum.offset = 0;
+        d_min_sum.factor = factor;
+    } else {
+        d_min_sum.offset = offset;
+        d_min_sum.factor = 1;
+    }
+    d_min_sum.self_corrected = (algorithm == LDPC_SELF_CORRECTED_MIN_SUM);
+
+    fec_info_t fec_info;
+    get_fec_info(standard, framesize, rate, fec_info);
+    d_kldpc = fec_info.ldpc.k;
+    d_nldpc = fec_info.ldpc.n;
+    d_kldpc_bytes = d_kldpc / 8;
+    d_nldpc_bytes = d_nldpc / 8;
+
+    // In CCM mode, the decoder uses the single LDPC code given by the frame size and
+    // code rate parameters. In ACM/VCM mode, it instantiates the code of every MODCOD
+    // enabled on the PLS filter upfront so that it can switch codes on every frame.
+    d_modcod_code.fill(-1);
+    if (acm_vcm) {
+        if (standard != STANDARD_DVBS2)
+            throw std::runtime_error("ACM/VCM mode is only supported for DVB-S2");
+        for (uint8_t pls = 4; pls < 128; pls++) { // skip dummy PLFRAMEs (MODCOD 0)
+            bool enabled = (pls < 64) ? (pls_filter_lo & (1ULL << pls))
+                                      : (pls_filter_hi & (1ULL << (pls - 64)));
+            const uint8_t modcod = pls >> 2;
+            const bool short_fecframe = pls & 2;
+            if (!enabled || modcod > 28) // MODCODs 29 to 31 are reserved
+                continue;
+            const dvb_framesize_t modcod_framesize =
+                short_fecframe ? FECFRAME_SHORT : FECFRAME_NORMAL;
+            const int code =
+                add_code(standard, modcod_framesize, dvbs2_modcod_rate[modcod - 1]);
+            if (code < 0) {
+                d_logger->warn("MODCOD {:d} ({:s} FECFRAME) is not supported",
+                               modcod,
+                               short_fecframe ? "short" : "normal");
+                continue;
+            }
+            // Frames with and without pilots share the same LDPC code
+            d_modcod_code[(modcod << 1) | short_fecframe] = code;
+        }
+        if (d_codes.empty())
+            throw std::runtime_error("No supported MODCOD enabled on the PLS filter");
+    } else if (add_code(standard, framesize, rate) < 0) {
+        throw std::runtime_error("Unsupported LDPC code");
+    }
 
-    decode = nullptr;
+    decode_stream[0] = decode_stream[1] = nullptr;
+    pack_hard = nullptr;
     std::string impl = "generic";
 #ifdef CPU_FEATURES_ARCH_ANY_ARM
     d_simd_size = 16;
@@ -317,54 +492,138 @@ ldpc_decoder_bb_impl::ldpc_decoder_bb_impl(dvb_standard_t standard,
     const bool has_neon = features.neon;
 #endif
     if (has_neon) {
-        ldpc_neon::ldpc_dec_init(d_ldpc);
-        decode = &ldpc_neon::ldpc_dec_decode;
+        SET_LDPC_DECODER(ldpc_neon);
         impl = "neon";
     } else {
-        ldpc_generic::ldpc_dec_init(d_ldpc);
-        decode = &ldpc_generic::ldpc_dec_decode;
+        SET_LDPC_DECODER(ldpc_generic);
     }
 #else
 #ifdef CPU_FEATURES_ARCH_X86
     const X86Features features = GetX86Info().features;
-    d_simd_size = features.avx2 ? 32 : 16;
-    if (features.avx2) {
-        ldpc_avx2::ldpc_dec_init(d_ldpc);
-        decode = &ldpc_avx2::ldpc_dec_decode;
+    d_simd_size = features.avx512bw ? 64 : (features.avx2 ? 32 : 16);
+    if (features.avx512bw) {
+        SET_LDPC_DECODER(ldpc_avx512);
+        impl = "avx512";
+    } else if (features.avx2) {
+        SET_LDPC_DECODER(ldpc_avx2);
         impl = "avx2";
     } else if (features.sse4_1) {
-        ldpc_sse41::ldpc_dec_init(d_ldpc);
-        decode = &ldpc_sse41::ldpc_dec_decode;
+        SET_LDPC_DECODER(ldpc_sse41);
         impl = "sse4_1";
     } else {
-        ldpc_generic::ldpc_dec_init(d_ldpc);
-        decode = &ldpc_generic::ldpc_dec_decode;
+        SET_LDPC_DECODER(ldpc_generic);
     }
 #else
     // Not ARM, nor x86. Use generic implementation.
     d_simd_size = 16;
-    ldpc_generic::ldpc_dec_init(d_ldpc);
-    decode = &ldpc_generic::ldpc_dec_decode;
+    SET_LDPC_DECODER(ldpc_generic);
 #endif
 #endif
-    assert(decode != nullptr);
-    d_debug_logger->debug("LDPC decoder implementation: {:s}", impl);
-    d_soft = new int8_t[d_ldpc->code_len() * d_simd_size];
-    d_aligned_buffer = aligned_alloc(d_simd_size, d_simd_size * d_ldpc->code_len());
-    if (outputmode == OM_MESSAGE) {
-        set_output_multiple(d_kldpc_bytes * d_simd_size);
-        set_relative_rate((double)d_kldpc_bytes / d_nldpc);
+    assert(decode_stream[0] != nullptr && decode_stream[1] != nullptr);
+    assert(pack_hard != nullptr);
+    d_debug_logger->debug("LDPC decoder implementation: {:s} ({:s} schedule)",
+                          impl,
+                          (schedule == LDPC_FLOODING) ? "flooding" : "layered");
+    d_debug_logger->debug("LDPC min-sum offset: {:g}, factor: {:g}, self-corrected: {}",
+                          d_min_sum.offset,
+                          d_min_sum.factor,
+                          d_min_sum.self_corrected);
+    for (const auto& code : d_codes) {
+        d_debug_logger->debug("LDPC code ({:d}, {:d}): {:d}-bit precision",
+                              code.n,
+                              code.ldpc->data_len(),
+                              code.int16 ? 16 : 8);
+    }
+
+    // Each worker thread gets its own decoder instances and buffers. The buffers are
+    // sized for the longest code. In ACM/VCM mode, the decoder instance of each code is
+    // created only when the first batch using the code is decoded, given that the
+    // stream may never use some of the enabled MODCODs.
+    if (num_threads < 1)
+        throw std::runtime_error("The number of LDPC decoding threads must be >= 1");
+    d_max_code_len = 0;
+    d_max_output_size = 0;
+    for (const auto& code : d_codes) {
+        d_max_code_len = std::max(d_max_code_len, code.n);
+        d_max_output_size = std::max(d_max_output_size, code.output_size);
+    }
+    d_worker_ctx.resize(num_threads);
+    for (auto& ctx : d_worker_ctx) {
+        ctx.decoders.assign(d_codes.size(), nullptr);
+        if (!d_acm_vcm)
+            ctx.decoders[0] =
+                create_decoder[d_codes[0].int16](d_codes[0].ldpc, d_min_sum);
+        ctx.aligned_buffer = aligned_alloc(d_simd_size, d_simd_size * d_max_code_len);
+    }
+    d_staging.resize(d_codes.size());
+    d_pool.reset(new worker_pool(num_threads));
+    d_debug_logger->debug("LDPC decoding threads: {:d}", num_threads);
+
+    const unsigned int output_size = (outputmode == OM_MESSAGE) ? d_kldpc_bytes
+                                                                : d_nldpc_bytes;
+    set_relative_rate((double)output_size / d_nldpc);
+    if (d_acm_vcm) {
+        // The frames are output one at a time, each with its own XFECFRAME tag. Make
+        // sure the output buffer can always fit the largest frame.
+        set_min_noutput_items(d_max_output_size);
+        set_tag_propagation_policy(TPP_DONT);
     } else {
-        set_output_multiple(d_nldpc_bytes * d_simd_size);
-        set_relative_rate((double)d_nldpc_bytes / d_nldpc);
+        // In throughput mode (negative batch timeout), the block processes complete
+        // SIMD batches only. It waits for a single batch, not one per decoding thread,
+        // so that the input buffer and latency do not grow with the number of threads.
+        // Whatever complete batches are available are then split among the threads. In
+        // latency mode, it processes one frame at a time so that a partially filled
+        // batch can be decoded once the batch timeout expires.
+        const int batch_frames = (d_batch_timeout_ms < 0) ? d_simd_size : 1;
+        set_output_multiple(output_size * batch_frames);
     }
 
     // Settings for LLR PDU port
+    if (llr_pdu_period < 0)
+        throw std::runtime_error("The LLR PDU period must be >= 0");
+    if (llr_pdu_frames < 0)
+        throw std::runtime_error("The number of frames per LLR PDU must be >= 0");
     d_pdu_meta = pmt::make_dict();
     d_pdu_meta =
         pmt::dict_add(d_pdu_meta, pmt::mp("simd_size"), pmt::from_long(d_simd_size));
     d_pdu_meta = pmt::dict_add(d_pdu_meta, pmt::mp("frame_cnt"), pmt::from_uint64(0));
     message_port_register_out(d_pdu_port_id);
+
+    // Preallocate the LLR PDU vectors for the expected PDU length. A vector is only
+    // reallocated when a batch publishes a different number of frames.
+    if (!d_acm_vcm && d_llr_pdu_period > 0) {
+        const int pdu_frames = (d_llr_pdu_frames > 0)
+                                   ? std::min(d_llr_pdu_frames, d_simd_size)
+                                   : d_simd_size;
+        for (int i = 0; i < LLR_PDU_POOL_SIZE; i++)
+            d_llr_pdu_pool.push_back(pmt::make_u8vector(pdu_frames * d_nldpc, 0));
+    }
+    d_debug_logger->debug("LLR PDU period: {:d} stream(s), frames: {:d}",
+                          d_llr_pdu_period,
+                          d_llr_pdu_frames);
+
+    // In latency mode, the timer thread posts to this port when the batch timeout
+    // expires, which wakes up the block even if no new input arrives. The message
+    // carries no information, so the handler has nothing to do.
+    message_port_register_in(d_timer_port_id);
+    set_msg_handler(d_timer_port_id, [](pmt::pmt_t) {});
+
+    // Command port for the trials parameters
+    message_port_register_in(d_cmd_port_id);
+    set_msg_handler(d_cmd_port_id,
+                    [this](pmt::pmt_t msg) { this->handle_cmd_msg(msg); });
+    d_debug_logger->debug("LDPC trials: max {:d}, min {:d}, backlog {:d} frame(s)",
+                          d_max_trials,
+                          d_min_trials,
+                          d_trials_backlog);
+
+    // Per-frame stats. The unsatisfied checks of the frames that fail to converge are
+    // counted on the parity-check structure of their codes.
+    message_port_register_out(d_stats_port_id);
+    if (d_frame_stats) {
+        for (auto& code : d_codes)
+            code.structure = ldpc_structure(code.ldpc);
+    }
 }
 
 /*
@@ -372,14 +631,125 @@ ldpc_decoder_bb_impl::ldpc_decoder_bb_impl(dvb_standard_t standard,
  */
 ldpc_decoder_bb_impl::~ldpc_decoder_bb_impl()
 {
-    free(d_aligned_buffer);
-    delete[] d_soft;
-    delete d_ldpc;
+    stop_batch_timer();
+    d_pool.reset(); // join the worker threads before releasing their resources
+    for (auto& ctx : d_worker_ctx) {
+        for (size_t i = 0; i < ctx.decoders.size(); i++) {
+            if (ctx.decoders[i] != nullptr)
+                destroy_decoder[d_codes[i].int16](ctx.decoders[i]);
+        }
+        free(ctx.aligned_buffer);
+    }
+    for (auto& code : d_codes)
+        delete code.ldpc;
+}
+
+bool ldpc_decoder_bb_impl::start()
+{
+    // The timer is only needed when a partial batch may wait for a positive timeout
+    if (d_batch_timeout_ms > 0) {
+        d_timer_stop = false;
+        d_timer_armed = false;
+        d_timer_thread = std::thread(&ldpc_decoder_bb_impl::timer_loop, this);
+    }
+    return block::start();
+}
+
+bool ldpc_decoder_bb_impl::stop()
+{
+    stop_batch_timer();
+    return block::stop();
+}
+
+void ldpc_decoder_bb_impl::stop_batch_timer()
+{
+    if (!d_timer_thread.joinable())
+        return;
+    {
+        std::lock_guard<std::mutex> lock(d_timer_mutex);
+        d_timer_stop = true;
+    }
+    d_timer_cv.notify_one();
+    d_timer_thread.join();
+}
+
+void ldpc_decoder_bb_impl::timer_loop()
+{
+    std::unique_lock<std::mutex> lock(d_timer_mutex);
+    while (!d_timer_stop) {
+        if (!d_timer_armed) {
+            d_timer_cv.wait(lock);
+            continue;
+        }
+        // Wait for the deadline unless it is cancelled or moved in the meantime
+        const auto deadline = d_timer_deadline;
+        d_timer_cv.wait_until(lock, deadline);
+        if (d_timer_stop || !d_timer_armed || d_timer_deadline != deadline ||
+            std::chrono::steady_clock::now() < deadline)
+            continue;
+        d_timer_armed = false;
+        lock.unlock();
+        post(d_timer_port_id, pmt::PMT_T);
+        lock.lock();
+    }
+}
+
+void ldpc_decoder_bb_impl::arm_batch_timer(std::chrono::steady_clock::time_point deadline)
+{
+    if (!d_timer_thread.joinable())
+        return;
+    {
+        std::lock_guard<std::mutex> lock(d_timer_mutex);
+        if (d_timer_armed && d_timer_deadline == deadline)
+            return;
+        d_timer_armed = true;
+        d_timer_deadline = deadline;
+    }
+    d_timer_cv.notify_one();
+}
+
+void ldpc_decoder_bb_impl::disarm_batch_timer()
+{
+    if (!d_timer_thread.joinable())
+        return;
+    std::lock_guard<std::mutex> lock(d_timer_mutex);
+    d_timer_armed = false; // the thread finds out when it wakes up
+}
+
+int ldpc_decoder_bb_impl::add_code(dvb_standard_t standard,
+                                   dvb_framesize_t framesize,
+                                   dvb_code_rate_t rate)
+{
+    for (size_t i = 0; i < d_codes.size(); i++) {
+        if (d_codes[i].framesize == framesize && d_codes[i].rate == rate)
+            return i;
+    }
+
+    LDPCInterface* ldpc = new_ldpc_code(standard, framesize, rate);
+    if (ldpc == nullptr)
+        return -1;
+
+    fec_info_t fec_info;
+    get_fec_info(standard, framesize, rate, fec_info);
+    const unsigned int output_size =
+        (d_output_mode == OM_MESSAGE) ? fec_info.ldpc.k / 8 : fec_info.ldpc.n / 8;
+    const bool int16 = (d_precision == LDPC_PRECISION_INT16) ||
+                       (d_precision == LDPC_PRECISION_AUTO && auto_int16(rate));
+    d_codes.push_back({ ldpc, framesize, rate, fec_info.ldpc.n, output_size, int16 });
+    return d_codes.size() - 1;
 }
 
 void ldpc_decoder_bb_impl::forecast(int noutput_items,
                                     gr_vector_int& ninput_items_required)
 {
+    if (d_acm_vcm) {
+        // The frame length is only known once the XFECFRAME tag arrives. Also, decoded
+        // frames may be waiting for output space, in which case no input is required.
+        const bool output_pending = !d_acm_frames.empty() && d_acm_frames.front().decoded;
+        ninput_items_required[0] = output_pending ? 0 : 1;
+        return;
+    }
+
     if (d_output_mode == OM_MESSAGE) {
         unsigned int n_frames = noutput_items / d_kldpc_bytes;
         ninput_items_required[0] = n_frames * d_nldpc;
@@ -388,70 +758,518 @@ void ldpc_decoder_bb_impl::forecast(int noutput_items,
     }
 }
 
-const int DEFAULT_TRIALS = 25;
-#define FACTOR 2 // same factor used on the decoder implementation
+const int MAX_STREAM_BATCHES = 8; // max SIMD batches decoded as a single stream
+
+void ldpc_decoder_bb_impl::handle_cmd_msg(pmt::pmt_t msg)
+{
+    gr::thread::scoped_lock l(d_mutex);
+
+    static const pmt::pmt_t max_trials_key = pmt::intern("max_trials");
+    static const pmt::pmt_t min_trials_key = pmt::intern("min_trials");
+    static const pmt::pmt_t trials_backlog_key = pmt::intern("trials_backlog");
+
+    if (!pmt::is_dict(msg)) {
+        throw std::runtime_error("ldpc_decoder_bb: Command message "
+                                 "must be a PMT dictionary");
+    }
+
+    // Validate all values before applying any of them
+    int max_trials = d_max_trials;
+    int min_trials = d_min_trials;
+    int trials_backlog = d_trials_backlog;
+    bool handled = false;
+    if (pmt::dict_has_key(msg, max_trials_key)) {
+        max_trials = pmt::to_long(pmt::dict_ref(msg, max_trials_key, pmt::PMT_NIL));
+        if (max_trials < 1)
+            throw std::runtime_error("ldpc_decoder_bb: max_trials must be >= 1");
+        handled = true;
+    }
+    if (pmt::dict_has_key(msg, min_trials_key)) {
+        min_trials = pmt::to_long(pmt::dict_ref(msg, min_trials_key, pmt::PMT_NIL));
+        if (min_trials < 0)
+            throw std::runtime_error("ldpc_decoder_bb: min_trials must be >= 0");
+        handled = true;
+    }
+    if (pmt::dict_has_key(msg, trials_backlog_key)) {
+        trials_backlog =
+            pmt::to_long(pmt::dict_ref(msg, trials_backlog_key, pmt::PMT_NIL));
+        if (trials_backlog < 0)
+            throw std::runtime_error("ldpc_decoder_bb: trials_backlog must be >= 0");
+        handled = true;
+    }
+
+    if (!handled) {
+        throw std::runtime_error("ldpc_decoder_bb: Unsupported command message");
+    }
+
+    d_max_trials = max_trials;
+    d_min_trials = min_trials;
+    d_trials_backlog = trials_backlog;
+    if (d_min_trials == 0 || d_min_trials >= d_max_trials)
+        d_trials_cap = d_max_trials;
+    else
+        d_trials_cap = std::clamp(d_trials_cap, d_min_trials, d_max_trials);
+    d_debug_logger->debug("LDPC trials: max {:d}, min {:d}, backlog {:d} frame(s)",
+                          d_max_trials,
+                          d_min_trials,
+                          d_trials_backlog);
+}
+
+int ldpc_decoder_bb_impl::update_trials_cap(int n_available)
+{
+    gr::thread::scoped_lock l(d_mutex);
+    if (d_min_trials == 0 || d_min_trials >= d_max_trials)
+        return d_trials_cap; // adaptive control disabled
+
+    // Ignore the remainder short of a complete batch, which only waits for more input,
+    // and the batches the decoding threads can take at once.
+    const int n_batches = n_available / d_simd_size - (int)d_pool->size();
+    const int backlog = std::max(n_batches, 0) * d_simd_size;
+
+    // Back off quickly under pressure and recover gradually, so that a sustained
+    // backlog is drained within a few calls while a short burst barely costs any
+    // decoding performance.
+    const int threshold = (d_trials_backlog > 0) ? d_trials_backlog : d_simd_size;
+    const int prev_cap = d_trials_cap;
+    if (backlog >= threshold)
+        d_trials_cap -= (d_trials_cap - d_min_trials + 1) / 2;
+    else if (2 * backlog < threshold && d_trials_cap < d_max_trials)
+        d_trials_cap++;
+    if (d_trials_cap != prev_cap) {
+        GR_LOG_DEBUG_LEVEL(1,
+                           "Trials cap: {:d} (backlog: {:d} frame(s))",
+                           d_trials_cap,
+                           backlog);
+    }
+    return d_trials_cap;
+}
+
+void ldpc_decoder_bb_impl::attach_llr_pdu(ldpc_batch_t& batch, uint64_t batch_idx)
+{
+    if (d_llr_pdu_period == 0 || batch_idx % d_llr_pdu_period != 0)
+        return;
+
+    // Cap the PDU at one SIMD batch, as the XFECFRAME demapper only keeps a couple of
+    // batches around to match the decoded LLRs against.
+    const int max_frames =
+        (d_llr_pdu_frames > 0) ? std::min(d_llr_pdu_frames, d_simd_size) : d_simd_size;
+    const int n_frames = std::min(max_frames, batch.n_frames);
+    const size_t n_llr = n_frames * d_codes[batch.code].n;
+    batch.llr_frame = batch.n_frames - n_frames;
+
+    // A vector referenced only by the pool is no longer held by any message in flight.
+    // Prefer one with the right length, and reallocate another one otherwise.
+    pmt::pmt_t* free_vec = nullptr;
+    for (auto& vec : d_llr_pdu_pool) {
+        if (vec.use_count() > 1)
+            continue;
+        if (pmt::length(vec) == n_llr) {
+            batch.llr = vec;
+            return;
+        }
+        free_vec = &vec;
+    }
+    if (free_vec == nullptr) {
+        d_skipped_llr_pdus++;
+        GR_LOG_DEBUG_LEVEL(
+            2, "LLR PDU pool busy, {:d} PDUs skipped so far", d_skipped_llr_pdus);
+        return;
+    }
+    *free_vec = pmt::make_u8vector(n_llr, 0);
+    batch.llr = *free_vec;
+}
+
+void ldpc_decoder_bb_impl::decode_batch(ldpc_worker_ctx_t& ctx,
+                                        ldpc_batch_t& batch,
+                                        int trials)
+{
+    const auto start = std::chrono::steady_clock::now();
+    const ldpc_code_t& code = d_codes[batch.code];
+    const int CODE_LEN = code.n;
+    const int output_size = code.output_size;
+    const int n_frames = batch.n_frames;
+
+    // When the LLR PDU takes the whole batch, decode straight into the PDU vector.
+    // Otherwise, decode into the worker's soft buffer and copy the last frames.
+    int8_t* pdu_llr = nullptr;
+    size_t n_pdu_llr = 0;
+    if (!pmt::is_null(batch.llr)) {
+        pdu_llr = static_cast<int8_t*>(
+            pmt::uniform_vector_writable_elements(batch.llr, n_pdu_llr));
+    }
+    int8_t* soft;
+    if (n_pdu_llr == (size_t)CODE_LEN * n_frames) {
+        soft = pdu_llr;
+    } else {
+        if (ctx.soft.size() < (size_t)CODE_LEN * n_frames)
+            ctx.soft.resize(CODE_LEN * n_frames);
+        soft = ctx.soft.data();
+    }
+
+    // LDPC Decoding straight from the input buffer
+    void*& decoder = ctx.decoders[batch.code];
+    if (decoder == nullptr)
+        decoder = create_decoder[code.int16](code.ldpc, d_min_sum);
+    decode_stream[code.int16](
+        decoder, ctx.aligned_buffer, batch.in, soft, trials, n_frames, batch.counts);
+
+    // Decoded LLRs for the XFECFRAME demapper
+    if (pdu_llr != nullptr && pdu_llr != soft)
+        memcpy(pdu_llr, soft + batch.llr_frame * CODE_LEN, n_pdu_llr);
+
+    // Output bit-packed bytes with the hard decisions and with the MSB first
+    for (int blk = 0; blk < n_frames; blk++) {
+        pack_hard(soft + blk * CODE_LEN,
+                  batch.out + blk * output_size,
+                  output_size);
+    }
+
+    // The converged frames satisfy all checks by definition, so only count those left
+    // unsatisfied by the frames that ran out of trials.
+    if (d_frame_stats) {
+        for (int blk = 0; blk < n_frames; blk++) {
+            batch.unsatisfied[blk] =
+                (batch.counts[blk] < 0)
+                    ? ldpc_unsatisfied_checks(*code.structure, soft + blk * CODE_LEN)
+                    : 0;
+        }
+        batch.decode_us = std::chrono::duration<double, std::micro>(
+                              std::chrono::steady_clock::now() - start)
+                              .count();
+    }
+}
+
+void ldpc_decoder_bb_impl::decode_batches(int trials)
+{
+    size_t n_frames = 0;
+    for (const auto& batch : d_batches)
+        n_frames += batch.n_frames;
+    d_frame_counts.resize(n_frames);
+    d_frame_unsat.resize(n_frames);
+    int* counts = d_frame_counts.data();
+    int* unsatisfied = d_frame_unsat.data();
+    for (auto& batch : d_batches) {
+        batch.counts = counts;
+        batch.unsatisfied = unsatisfied;
+        counts += batch.n_frames;
+        unsatisfied += batch.n_frames;
+    }
+
+    d_pool->parallel_for(d_batches.size(), [&](size_t i_batch, unsigned int i_worker) {
+        decode_batch(d_worker_ctx[i_worker], d_batches[i_batch], trials);
+    });
+}
+
+void ldpc_decoder_bb_impl::finish_batch(const ldpc_batch_t& batch, int trials)
+{
+    static const pmt::pmt_t frame_key = pmt::intern("frame");
+    static const pmt::pmt_t iterations_key = pmt::intern("iterations");
+    static const pmt::pmt_t converged_key = pmt::intern("converged");
+    static const pmt::pmt_t unsatisfied_key = pmt::intern("unsatisfied_checks");
+    static const pmt::pmt_t batch_frames_key = pmt::intern("batch_frames");
+    static const pmt::pmt_t batch_time_key = pmt::intern("batch_time_us");
+
+    d_batch_stats.clear();
+    for (int i = 0; i < batch.n_frames; i++) {
+        const uint64_t frame = d_frame_cnt + i;
+        const bool converged = batch.counts[i] >= 0;
+        const int frame_trials = converged ? (trials - batch.counts[i]) : trials;
+        d_total_trials += frame_trials;
+        if (converged) {
+            GR_LOG_DEBUG_LEVEL(1, "frame = {:d}, trials = {:d}", frame, frame_trials);
+        } else {
+            GR_LOG_DEBUG_LEVEL(1, "frame = {:d}, trials = {:d} (max)", frame, trials);
+        }
+
+        if (d_frame_stats) {
+            pmt::pmt_t stats = pmt::make_dict();
+            stats = pmt::dict_add(stats, frame_key, pmt::from_uint64(frame));
+            stats = pmt::dict_add(stats, iterations_key, pmt::from_long(frame_trials));
+            stats = pmt::dict_add(stats, converged_key, pmt::from_bool(converged));
+            stats = pmt::dict_add(
+                stats, unsatisfied_key, pmt::from_long(batch.unsatisfied[i]));
+            stats = pmt::dict_add(stats, batch_frames_key, pmt::from_long(batch.n_frames));
+            stats =
+                pmt::dict_add(stats, batch_time_key, pmt::from_double(batch.decode_us));
+            message_port_pub(d_stats_port_id, stats);
+            d_batch_stats.push_back(stats);
+        }
+    }
+
+    // Send decoded LLRs so that the XFECFRAME demapper can refine its SNR estimate. The
+    // PDU holds the last frames of the batch, which are consecutive. In ACM/VCM mode,
+    // where a batch may group non-consecutive frames, no PDU is attached to the batch.
+    if (!pmt::is_null(batch.llr)) {
+        const long pdu_frames = pmt::length(batch.llr) / d_codes[batch.code].n;
+        d_pdu_meta =
+            pmt::dict_add(d_pdu_meta, pmt::mp("simd_size"), pmt::from_long(pdu_frames));
+        d_pdu_meta = pmt::dict_add(
+            d_pdu_meta,
+            pmt::mp("frame_cnt"),
+            pmt::from_uint64(d_frame_cnt + batch.llr_frame));
+        message_port_pub(d_pdu_port_id, pmt::cons(d_pdu_meta, batch.llr));
+    }
+
+    d_frame_cnt += batch.n_frames;
+    d_batch_cnt++;
+}
 
 int ldpc_decoder_bb_impl::general_work(int noutput_items,
                                        gr_vector_int& ninput_items,
                                        gr_vector_const_void_star& input_items,
                                        gr_vector_void_star& output_items)
 {
+    if (d_acm_vcm)
+        return general_work_acm_vcm(
+            noutput_items, ninput_items, input_items, output_items);
+
     const int8_t* in = (const int8_t*)input_items[0];
     unsigned char* out = (unsigned char*)output_items[0];
-    const int CODE_LEN = d_ldpc->code_len();
-    const int trials = (d_max_trials == 0) ? DEFAULT_TRIALS : d_max_trials;
-    int consumed = 0;
-    int output_size = d_output_mode ? d_kldpc_bytes : d_nldpc_bytes;
-
-    for (int i = 0; i < noutput_items; i += output_size * d_simd_size) {
-        memcpy(d_soft, in + consumed, d_nldpc * d_simd_size * sizeof(int8_t));
-
-        // LDPC Decoding
-        int count = decode(d_aligned_buffer, d_soft, trials);
-        if (count < 0) {
-            d_total_trials += trials;
-            GR_LOG_DEBUG_LEVEL(
-                1, "frame = {:d}, trials = {:d} (max)", d_frame_cnt, trials);
-        } else {
-            d_total_trials += (trials - count);
-            GR_LOG_DEBUG_LEVEL(
-                1, "frame = {:d}, trials = {:d}", d_frame_cnt, (trials - count));
-        }
+    const int output_size = d_output_mode ? d_kldpc_bytes : d_nldpc_bytes;
+    const int n_available = ninput_items[0] / d_nldpc;
+    const int n_frames = std::min(noutput_items / output_size, n_available);
+    const int n_full_batch_frames = n_frames - (n_frames % d_simd_size);
+    int n_decoded = 0;
 
-        // Send decoded LLRs so that the XFECFRAME demapper can refine its SNR estimate
-        d_pdu_meta = pmt::dict_add(
-            d_pdu_meta, pmt::mp("frame_cnt"), pmt::from_uint64(d_frame_cnt));
-        message_port_pub(
-            d_pdu_port_id,
-            pmt::cons(d_pdu_meta,
-                      pdu::make_pdu_vector(types::byte_t,
-                                           reinterpret_cast<const uint8_t*>(d_soft),
-                                           d_nldpc * d_simd_size)));
-
-        // Output bit-packed bytes with the hard decisions and with the MSB first
-        for (int blk = 0; blk < d_simd_size; blk++) {
-            for (int j = 0; j < output_size; j++) {
-                *out = 0;
-                for (int k = 0; k < 8; k++) {
-                    if (d_soft[(j * 8) + k + (blk * CODE_LEN)] < 0) {
-                        *out |= 1 << (7 - k);
-                    }
-                }
-                out++;
-            }
+    // Split the complete SIMD batches evenly among the decoding threads. Each thread
+    // decodes its share as a single stream, so that the SIMD lanes freed by the frames
+    // converging early are recycled with the next frames of the stream. Limit the
+    // stream length so that the streams, which publish one LLR PDU each, keep a steady
+    // PDU rate.
+    const int n_full_batches = n_full_batch_frames / d_simd_size;
+    const int n_streams = std::max(
+        (n_full_batches + MAX_STREAM_BATCHES - 1) / MAX_STREAM_BATCHES,
+        std::min(n_full_batches, (int)d_pool->size()));
+    d_batches.clear();
+    for (int i = 0; i < n_streams; i++) {
+        const int n_stream_batches = (n_full_batches * (i + 1)) / n_streams -
+                                     (n_full_batches * i) / n_streams;
+        const int n_stream_frames = n_stream_batches * d_simd_size;
+        d_batches.push_back({ 0, in, out, n_stream_frames, nullptr, pmt::PMT_NIL });
+        attach_llr_pdu(d_batches.back(), d_batch_cnt + i);
+        in += d_nldpc * n_stream_frames;
+        out += output_size * n_stream_frames;
+        n_decoded += n_stream_frames;
+    }
+
+    // Latency mode: decode a partially filled batch once the oldest frame on it has
+    // waited for the configured timeout. The timeout is evaluated whenever the
+    // scheduler calls this function, and the timer thread makes sure there is a call
+    // once the timeout expires, even if no new input or output space arrives.
+    const int n_partial_batch_frames = n_frames - n_full_batch_frames;
+    if (n_full_batch_frames > 0 || n_partial_batch_frames == 0) {
+        d_partial_pending = false;
+    }
+    if (d_batch_timeout_ms >= 0 && n_partial_batch_frames > 0) {
+        const auto now = std::chrono::steady_clock::now();
+        if (!d_partial_pending) {
+            d_partial_pending = true;
+            d_partial_since = now;
         }
+        if (now - d_partial_since >= std::chrono::milliseconds(d_batch_timeout_ms)) {
+            d_batches.push_back(
+                { 0, in, out, n_partial_batch_frames, nullptr, pmt::PMT_NIL });
+            attach_llr_pdu(d_batches.back(), d_batch_cnt + d_batches.size() - 1);
+            n_decoded += n_partial_batch_frames;
+            d_partial_pending = false;
+        }
+    }
+    if (d_partial_pending)
+        arm_batch_timer(d_partial_since + std::chrono::milliseconds(d_batch_timeout_ms));
+    else
+        disarm_batch_timer();
 
-        consumed += d_nldpc * d_simd_size;
-        d_frame_cnt += d_simd_size;
-        d_batch_cnt++;
+    // Decode the batches concurrently. Each batch writes into its own output slice, so
+    // the output order is preserved. Then, publish the results in order.
+    const int trials = update_trials_cap(n_available);
+    decode_batches(trials);
+    const unsigned char* out_start = (const unsigned char*)output_items[0];
+    for (const auto& batch : d_batches) {
+        finish_batch(batch, trials);
+        const uint64_t offset = nitems_written(0) + (batch.out - out_start);
+        for (size_t i = 0; i < d_batch_stats.size(); i++) {
+            add_item_tag(
+                0, offset + i * output_size, d_stats_tag_key, d_batch_stats[i]);
+        }
     }
 
     // Tell runtime system how many input items we consumed on
     // each input stream.
-    consume_each(consumed);
+    consume_each(n_decoded * d_nldpc);
 
     // Tell runtime system how many output items we produced.
-    return noutput_items;
+    return n_decoded * output_size;
+}
+
+int ldpc_decoder_bb_impl::general_work_acm_vcm(int noutput_items,
+                                               gr_vector_int& ninput_items,
+                                               gr_vector_const_void_star& input_items,
+                                               gr_vector_void_star& output_items)
+{
+    const int8_t* in = (const int8_t*)input_items[0];
+    unsigned char* out = (unsigned char*)output_items[0];
+    const int n_input = ninput_items[0];
+    const uint64_t n_read = nitems_read(0);
+    const auto now = std::chrono::steady_clock::now();
+    int n_consumed = 0;
+
+    // Frames available at the start of the call for the adaptive trials control,
+    // including those staged on previous calls, with the input counted in frames of
+    // the longest code.
+    int n_available = n_input / d_max_code_len;
+    for (const auto& staging : d_staging)
+        n_available += staging.frames.size();
+
+    // Bound the number of pending frames so that the batches of infrequent codes do not
+    // hold the output indefinitely. Once the bound is reached, the partial batch holding
+    // the oldest pending frame is decoded regardless of the batch timeout.
+    const size_t max_pending = d_simd_size * std::max(d_n_active_codes, 1u);
+
+    // Split the input into XFECFRAMEs and stage each frame on the batch of its LDPC
+    // code. Each frame must start at an XFECFRAME tag. Drop the LLRs preceding the next
+    // tag when out of sync and the frames truncated by a premature tag.
+    std::vector<tag_t> tags;
+    get_tags_in_range(tags, 0, n_read, n_read + n_input, d_xfecframe_tag_key);
+    auto tag = tags.begin();
+    uint64_t n_dropped = 0;
+    while (d_acm_frames.size() < max_pending) {
+        const uint64_t offset = n_read + n_consumed;
+        while (tag != tags.end() && tag->offset < offset)
+            tag++;
+        if (tag == tags.end()) {
+            n_dropped += n_input - n_consumed;
+            n_consumed = n_input;
+            break;
+        }
+        if (tag->offset > offset) {
+            n_dropped += tag->offset - offset;
+            n_consumed = tag->offset - n_read;
+            continue;
+        }
+
+        const long modcod = pmt::to_long(pmt::car(tag->value));
+        const bool short_fecframe = pmt::to_bool(pmt::cdr(tag->value));
+        const int frame_len = short_fecframe ? FRAME_SIZE_SHORT : FRAME_SIZE_NORMAL;
+        const auto next_tag = std::find_if(
+            tag, tags.end(), [&](const tag_t& t) { return t.offset > offset; });
+        if (next_tag != tags.end() && next_tag->offset < offset + frame_len) {
+            n_dropped += next_tag->offset - offset;
+            n_consumed = next_tag->offset - n_read;
+            continue;
+        }
+        if (n_input - n_consumed < frame_len)
+            break; // wait for the rest of the frame
+
+        const int code = (modcod > 0 && modcod < 32)
+                             ? d_modcod_code[(modcod << 1) | short_fecframe]
+                             : -1;
+        if (code < 0) {
+            GR_LOG_DEBUG_LEVEL(
+                1, "Dropping frame with disabled or unsupported MODCOD {:d}", modcod);
+            n_consumed += frame_len;
+            continue;
+        }
+
+        auto& staging = d_staging[code];
+        if (staging.frames.size() == (size_t)d_simd_size)
+            break; // wait until the code's batch is decoded
+        if (staging.llr.empty()) {
+            staging.llr.resize(d_simd_size * d_codes[code].n);
+            staging.out.resize(d_simd_size * d_codes[code].output_size);
+            d_n_active_codes++;
+        }
+        memcpy(staging.llr.data() + staging.frames.size() * frame_len,
+               in + n_consumed,
+               frame_len * sizeof(int8_t));
+        d_acm_frames.push_back({ code, tag->value, now, false, {}, pmt::PMT_NIL });
+        staging.frames.push_back(&d_acm_frames.back());
+        n_consumed += frame_len;
+    }
+    if (n_dropped > 0) {
+        d_dropped_llrs += n_dropped;
+        GR_LOG_DEBUG_LEVEL(1,
+                           "Dropped {:d} LLRs while searching for an XFECFRAME tag "
+                           "(total: {:d})",
+                           n_dropped,
+                           d_dropped_llrs);
+    }
+
+    // Decode the complete batches. Also, decode the partial batch holding the oldest
+    // pending frame if the pending frame limit is reached or, in latency mode, if the
+    // oldest frame has waited for the batch timeout.
+    d_batches.clear();
+    for (size_t i = 0; i < d_staging.size(); i++) {
+        auto& staging = d_staging[i];
+        if (staging.frames.size() == (size_t)d_simd_size) {
+            d_batches.push_back({ (int)i,
+                                  staging.llr.data(),
+                                  staging.out.data(),
+                                  d_simd_size,
+                                  nullptr,
+                                  pmt::PMT_NIL });
+        }
+    }
+    if (!d_acm_frames.empty() && !d_acm_frames.front().decoded) {
+        const ldpc_acm_frame_t& oldest = d_acm_frames.front();
+        auto& staging = d_staging[oldest.code];
+        const bool timeout =
+            d_batch_timeout_ms >= 0 &&
+            (now - oldest.arrival) >= std::chrono::milliseconds(d_batch_timeout_ms);
+        if (staging.frames.size() < (size_t)d_simd_size &&
+            (d_acm_frames.size() >= max_pending || timeout)) {
+            d_batches.push_back({ oldest.code,
+                                  staging.llr.data(),
+                                  staging.out.data(),
+                                  (int)staging.frames.size(),
+                                  nullptr,
+                                  pmt::PMT_NIL });
+        }
+    }
+
+    const int trials = update_trials_cap(n_available);
+
+    decode_batches(trials);
+    for (const auto& batch : d_batches) {
+        finish_batch(batch, trials);
+        auto& staging = d_staging[batch.code];
+        const unsigned int output_size = d_codes[batch.code].output_size;
+        for (int i = 0; i < batch.n_frames; i++) {
+            const unsigned char* frame_out = staging.out.data() + i * output_size;
+            staging.frames[i]->out.assign(frame_out, frame_out + output_size);
+            staging.frames[i]->decoded = true;
+            if (d_frame_stats)
+                staging.frames[i]->stats = d_batch_stats[i];
+        }
+        staging.frames.clear();
+    }
+
+    // In latency mode, make sure the block wakes up when the oldest pending frame times
+    // out, in case no new input arrives until then.
+    if (!d_acm_frames.empty() && !d_acm_frames.front().decoded)
+        arm_batch_timer(d_acm_frames.front().arrival +
+                        std::chrono::milliseconds(d_batch_timeout_ms));
+    else
+        disarm_batch_timer();
+
+    // Output the decoded frames in their original order, each with its XFECFRAME tag
+    int n_produced = 0;
+    while (!d_acm_frames.empty() && d_acm_frames.front().decoded) {
+        const ldpc_acm_frame_t& frame = d_acm_frames.front();
+        const int output_size = frame.out.size();
+        if (output_size > noutput_items - n_produced)
+            break;
+        memcpy(out + n_produced, frame.out.data(), output_size);
+        add_item_tag(0, nitems_written(0) + n_produced, d_xfecframe_tag_key, frame.tag);
+        if (d_frame_stats) {
+            add_item_tag(
+                0, nitems_written(0) + n_produced, d_stats_tag_key, frame.stats);
+        }
+        n_produced += output_size;
+        d_acm_frames.pop_front();
+    }
+
+    consume_each(n_consumed);
+    return n_produced;
 }
 
 } /* namespace dvbs2rx */
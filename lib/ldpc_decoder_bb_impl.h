@@ -16,11 +16,81 @@
 #include "dvb_s2x_tables.hh"
 #include "dvb_t2_tables.hh"
 #include "ldpc_decoder/ldpc.hh"
+#include "ldpc_decoder/ldpc_decoder_isa.hh"
+#include "ldpc_decoder/ldpc_structure.hh"
+#include "worker_pool.h"
 #include <gnuradio/dvbs2rx/ldpc_decoder_bb.h>
+#include <gnuradio/thread/thread.h>
+#include <array>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
 
 namespace gr {
 namespace dvbs2rx {
 
+/**
+ * @brief LDPC code supported by the decoder.
+ */
+struct ldpc_code_t {
+    LDPCInterface* ldpc;       /**< LDPC code table */
+    dvb_framesize_t framesize; /**< FECFRAME size */
+    dvb_code_rate_t rate;      /**< Code rate */
+    unsigned int n;            /**< Codeword length in bits */
+    unsigned int output_size;  /**< Output bytes per frame (codeword or message) */
+    bool int16;                /**< Whether decoded with 16-bit precision */
+    std::shared_ptr<const LDPCStructure> structure; /**< Parity checks (for stats) */
+};
+
+/**
+ * @brief Decoding resources owned by each worker thread.
+ */
+struct ldpc_worker_ctx_t {
+    std::vector<void*> decoders; /**< ISA-specific decoder instance of each code */
+    void* aligned_buffer;        /**< Decoder's SIMD-aligned working buffer */
+    std::vector<int8_t> soft;    /**< Decoded LLRs of the frames of a batch */
+};
+
+/**
+ * @brief Batch of frames to be decoded by one of the worker threads.
+ */
+struct ldpc_batch_t {
+    int code;           /**< Index of the LDPC code shared by the batch frames */
+    const int8_t* in;   /**< Input LLRs */
+    unsigned char* out; /**< Output buffer for the bit-packed hard decisions */
+    int n_frames;       /**< Number of frames in the batch */
+    int* counts;        /**< Remaining decoding trials per frame (negative if failed) */
+    pmt::pmt_t llr;     /**< LLR PDU vector taking the batch's decoded LLRs, if any */
+    int llr_frame;      /**< Index of the first batch frame published on the PDU */
+    int* unsatisfied;   /**< Unsatisfied parity checks per frame (for stats) */
+    double decode_us;   /**< Time taken to decode the batch in microseconds */
+};
+
+/**
+ * @brief XFECFRAME waiting to be decoded or output in ACM/VCM mode.
+ */
+struct ldpc_acm_frame_t {
+    int code;                                      /**< Index of the LDPC code */
+    pmt::pmt_t tag;                                /**< XFECFRAME tag value */
+    std::chrono::steady_clock::time_point arrival; /**< Time of arrival */
+    bool decoded;                                  /**< Whether it was decoded */
+    std::vector<unsigned char> out;                /**< Decoder output */
+    pmt::pmt_t stats;                              /**< Decoding statistics */
+};
+
+/**
+ * @brief Batch of ACM/VCM frames being gathered for a given LDPC code.
+ */
+struct ldpc_acm_staging_t {
+    std::vector<int8_t> llr;               /**< Input LLRs of the staged frames */
+    std::vector<unsigned char> out;        /**< Decoder output of the staged frames */
+    std::vector<ldpc_acm_frame_t*> frames; /**< Staged frames */
+};
+
 class ldpc_decoder_bb_impl : public ldpc_decoder_bb
 {
 private:
@@ -32,15 +102,181 @@ private:
     unsigned int d_output_mode;  /**< Output full codeword or just message */
     uint64_t d_frame_cnt;        /**< Frame count */
     uint64_t d_batch_cnt;        /**< Frame batch count */
-    unsigned int d_total_trials; /**< Total LDPC decoding trials */
+    uint64_t d_total_trials;     /**< Total LDPC decoding trials */
     int d_max_trials;            /**< Max decoding trials per frame */
-    LDPCInterface* d_ldpc;
+    int d_min_trials;            /**< Min trials cap of the adaptive control (0 if off) */
+    int d_trials_backlog;        /**< Backlog lowering the trials cap, in frames */
+    int d_trials_cap;            /**< Current cap on the decoding trials per frame */
+    gr::thread::mutex d_mutex;   /**< Protects the trials parameters and cap */
+    std::vector<ldpc_code_t> d_codes; /**< LDPC codes (a single one in CCM mode) */
     int d_simd_size; /**< Number of bytes on the SIMD register */
-    int8_t* d_soft;
-    void* d_aligned_buffer;
-    int (*decode)(void*, int8_t*, int);
+    const dvb_ldpc_precision_t d_precision; /**< Precision of the LLRs and messages */
+    ldpc_min_sum_t d_min_sum;               /**< Check node update rule */
+    // Decoder entry points indexed by the precision (0 for 8 bits, 1 for 16 bits)
+    void* (*create_decoder[2])(LDPCInterface*, const ldpc_min_sum_t&);
+    void (*destroy_decoder[2])(void*);
+    int (*decode_stream[2])(void*, void*, const int8_t*, int8_t*, int, int, int*);
+    void (*pack_hard)(const int8_t*, uint8_t*, int);
+    std::vector<ldpc_worker_ctx_t> d_worker_ctx; /**< Per-worker decoding resources */
+    std::unique_ptr<worker_pool> d_pool;         /**< Decoding thread pool */
+    std::vector<ldpc_batch_t> d_batches;         /**< Batches of the current work call */
+    std::vector<int> d_frame_counts; /**< Decoding results of the current work call */
+    std::vector<int> d_frame_unsat;  /**< Unsatisfied checks of the current work call */
     pmt::pmt_t d_pdu_meta;
     const pmt::pmt_t d_pdu_port_id = pmt::mp("llr_pdu");
+    const int d_llr_pdu_period; /**< Batches per LLR PDU (0 to disable the PDUs) */
+    const int d_llr_pdu_frames; /**< Max frames per LLR PDU (0 for the whole batch) */
+    std::vector<pmt::pmt_t> d_llr_pdu_pool; /**< Reusable LLR PDU vectors */
+    uint64_t d_skipped_llr_pdus; /**< LLR PDUs skipped while the pool was busy */
+
+    // Per-frame decoding statistics
+    const bool d_frame_stats;                /**< Whether to tag and publish the stats */
+    std::vector<pmt::pmt_t> d_batch_stats;   /**< Stats of each frame of the last batch */
+    const pmt::pmt_t d_stats_port_id = pmt::mp("stats");
+    const pmt::pmt_t d_stats_tag_key = pmt::mp("ldpc_stats");
+
+    // Latency-bounded (partial batch) mode
+    const int d_batch_timeout_ms; /**< Max wait for a complete batch (<0 to disable) */
+    bool d_partial_pending;       /**< Whether a partial batch is waiting */
+    std::chrono::steady_clock::time_point d_partial_since; /**< Start of the wait */
+    std::thread d_timer_thread;   /**< Wakes the block once the batch timeout expires */
+    std::mutex d_timer_mutex;     /**< Protects the timer state */
+    std::condition_variable d_timer_cv; /**< Signals timer changes to the thread */
+    bool d_timer_armed;                 /**< Whether the timer has a pending deadline */
+    bool d_timer_stop;                  /**< Whether the timer thread should exit */
+    std::chrono::steady_clock::time_point d_timer_deadline; /**< Timer deadline */
+    const pmt::pmt_t d_timer_port_id = pmt::mp("timer");
+
+    // ACM/VCM mode
+    const bool d_acm_vcm;                      /**< Whether running in ACM/VCM mode */
+    std::array<int, 64> d_modcod_code;         /**< Code index per MODCOD/frame size */
+    std::vector<ldpc_acm_staging_t> d_staging; /**< Batch being gathered per code */
+    std::deque<ldpc_acm_frame_t> d_acm_frames; /**< Frames pending decoding or output */
+    unsigned int d_n_active_codes;             /**< Number of codes received so far */
+    unsigned int d_max_code_len;               /**< Longest codeword length in bits */
+    unsigned int d_max_output_size;            /**< Largest output size per frame */
+    uint64_t d_dropped_llrs; /**< LLRs dropped while searching for a frame start */
+    const pmt::pmt_t d_xfecframe_tag_key = pmt::mp("XFECFRAME");
+    const pmt::pmt_t d_cmd_port_id = pmt::mp("cmd");
+
+    /**
+     * @brief Add an LDPC code to the list of codes supported by the decoder.
+     *
+     * @param standard DVB standard.
+     * @param framesize FECFRAME size.
+     * @param rate Code rate.
+     * @return int Index of the code on the list, or -1 if the code is not supported.
+     * @note Returns the index of the existing entry if the code is already on the list.
+     */
+    int
+    add_code(dvb_standard_t standard, dvb_framesize_t framesize, dvb_code_rate_t rate);
+
+    /**
+     * @brief Attach an LLR PDU vector to a batch if the batch is due to publish one.
+     *
+     * The PDU takes the last frames of the batch, up to one SIMD batch, which are the
+     * most likely to remain on the XFECFRAME demapper's buffer pool. The vectors come
+     * from a small pool and are reused once no message in flight references them
+     * anymore. When all vectors are still in use, e.g., because the
+     * downstream block lags behind, the batch does not publish its LLRs.
+     *
+     * @param batch Batch to be decoded.
+     * @param batch_idx Index of the batch since the start of the stream.
+     */
+    void attach_llr_pdu(ldpc_batch_t& batch, uint64_t batch_idx);
+
+    /**
+     * @brief Timer thread loop.
+     *
+     * Waits for the deadline set by arm_batch_timer() and then posts a message to the
+     * block's internal "timer" port. The message wakes up the block so that the work
+     * function can flush the partial batch even if no new input arrives.
+     */
+    void timer_loop();
+
+    /**
+     * @brief Set the deadline of the batch timeout timer.
+     *
+     * @param deadline Time at which the oldest frame of the partial batch times out.
+     */
+    void arm_batch_timer(std::chrono::steady_clock::time_point deadline);
+
+    /**
+     * @brief Cancel the pending deadline of the batch timeout timer, if any.
+     */
+    void disarm_batch_timer();
+
+    /**
+     * @brief Stop and join the timer thread, if running.
+     */
+    void stop_batch_timer();
+
+    /**
+     * @brief Handle a command message received on the "cmd" port.
+     *
+     * @param msg PMT dictionary with the new trials parameters.
+     */
+    void handle_cmd_msg(pmt::pmt_t msg);
+
+    /**
+     * @brief Update the trials cap based on the input backlog.
+     *
+     * The backlog comprises the complete SIMD batches available beyond one batch per
+     * decoding thread, i.e., beyond what a call decodes concurrently at the least. The
+     * cap is lowered halfway toward the minimum trials when the backlog reaches the
+     * threshold and raised by one trial when the backlog falls below half of it.
+     *
+     * @param n_available Number of input frames available at the start of the call.
+     * @return int Trials cap to apply on the batches of the work call.
+     */
+    int update_trials_cap(int n_available);
+
+    /**
+     * @brief Decode a batch of frames and output the corresponding hard decisions.
+     *
+     * This function can run concurrently on multiple worker threads, as long as each
+     * thread uses its own worker context. It only writes into the batch structure, the
+     * worker context, the batch's output buffer, and the batch's LLR PDU vector.
+     *
+     * @param ctx Worker context.
+     * @param batch Batch to decode. The frames are decoded as a stream, with each frame
+     * leaving its SIMD lane as soon as it converges and the next frame taking over the
+     * lane. Hence, the batch can have any number of frames, including fewer than the
+     * SIMD size. The decoding result of each frame is saved on the batch's counts.
+     * @param trials Maximum number of decoding iterations.
+     */
+    void decode_batch(ldpc_worker_ctx_t& ctx, ldpc_batch_t& batch, int trials);
+
+    /**
+     * @brief Decode the batches of the current work call concurrently.
+     *
+     * @param trials Maximum number of decoding iterations.
+     */
+    void decode_batches(int trials);
+
+    /**
+     * @brief Log and publish the results from a decoded batch.
+     *
+     * Must be called from the block's thread in the batch order. When the frame stats
+     * are enabled, publishes the stats of each frame on the "stats" port and leaves
+     * them on d_batch_stats so that the caller can tag the frames on the output.
+     *
+     * @param batch Decoded batch.
+     * @param trials Maximum number of decoding iterations.
+     */
+    void finish_batch(const ldpc_batch_t& batch, int trials);
+
+    /**
+     * @brief Work function for the ACM/VCM mode.
+     *
+     * Splits the input into XFECFRAMEs based on the XFECFRAME tags, groups the frames
+     * sharing the same LDPC code into SIMD batches, and outputs the decoded frames in
+     * their original order.
+     */
+    int general_work_acm_vcm(int noutput_items,
+                             gr_vector_int& ninput_items,
+                             gr_vector_const_void_star& input_items,
+                             gr_vector_void_star& output_items);
 
 public:
     ldpc_decoder_bb_impl(dvb_standard_t standard,
@@ -50,9 +286,27 @@ public:
                          dvb_outputmode_t outputmode,
                          dvb_infomode_t infomode,
                          int max_trials,
-                         int debug_level);
+                         int debug_level,
+                         int batch_timeout_ms,
+                         int num_threads,
+                         bool acm_vcm,
+                         uint64_t pls_filter_lo,
+                         uint64_t pls_filter_hi,
+                         dvb_ldpc_schedule_t schedule,
+                         int llr_pdu_period,
+                         int llr_pdu_frames,
+                         dvb_ldpc_precision_t precision,
+                         dvb_ldpc_algorithm_t algorithm,
+                         float offset,
+                         float factor,
+                         int min_trials,
+                         int trials_backlog,
+                         bool frame_stats);
     ~ldpc_decoder_bb_impl();
 
+    bool start() override;
+    bool stop() override;
+
     void forecast(int noutput_items, gr_vector_int& ninput_items_required);
 
     int general_work(int noutput_items,
@@ -60,7 +314,16 @@ public:
                      gr_vector_const_void_star& input_items,
                      gr_vector_void_star& output_items);
 
-    unsigned int get_average_trials() { return d_total_trials / d_batch_cnt; }
+    unsigned int get_average_trials()
+    {
+        return (d_frame_cnt == 0) ? 0 : d_total_trials / d_frame_cnt;
+    }
+
+    int get_trials_cap()
+    {
+        gr::thread::scoped_lock l(d_mutex);
+        return d_trials_cap;
+    }
 };
 
 } // namespace dvbs2rx
@@ -0,0 +1,71 @@
+/* -*- c++ -*- */
+/*
+ * Copyright (c) 2024 Igor Freire.
+ *
+ * This file is part of gr-dvbs2rx.
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#include "bb_descrambler.h"
+#include <boost/test/data/test_case.hpp>
+#include <boost/test/unit_test.hpp>
+#include <random>
+#include <vector>
+
+namespace bdata = boost::unit_test::data;
+
+namespace gr {
+namespace dvbs2rx {
+
+// Reference descrambling: XOR bit by bit with the PRBS 1 + x^14 + x^15 initialized
+// with "100101010000000", as on Section 5.2.2 of the standard
+std::vector<unsigned char> ref_descramble(const std::vector<unsigned char>& in)
+{
+    std::vector<unsigned char> out(in);
+    std::vector<int> reg = { 1, 0, 0, 1, 0, 1, 0, 1, 0, 0, 0, 0, 0, 0, 0 };
+    for (size_t i = 0; i < in.size() * 8; i++) {
+        const int b = reg[13] ^ reg[14];
+        reg.insert(reg.begin(), b);
+        reg.pop_back();
+        out[i / 8] ^= b << (7 - (i % 8));
+    }
+    return out;
+}
+
+// BBFRAME lengths in bytes (short 1/4, normal 1/4, and normal 9/10) and offsets of the
+// BBFRAME relative to the start of the buffer
+BOOST_DATA_TEST_CASE(test_bb_descrambler,
+                     bdata::make({ 384, 2001, 7274 }) * bdata::make({ 0, 1, 7, 13 }),
+                     kbch_bytes,
+                     offset)
+{
+    std::mt19937 gen(kbch_bytes + offset);
+    std::vector<unsigned char> scrambled(kbch_bytes);
+    for (auto& byte : scrambled)
+        byte = gen();
+    const auto expected = ref_descramble(scrambled);
+
+    bb_descrambler descrambler(kbch_bytes);
+    std::vector<unsigned char> in_buf(kbch_bytes + offset);
+    std::vector<unsigned char> out_buf(kbch_bytes + offset);
+    std::copy(scrambled.begin(), scrambled.end(), in_buf.begin() + offset);
+
+    // Out of place
+    descrambler.descramble(in_buf.data() + offset, out_buf.data() + offset);
+    BOOST_CHECK_EQUAL_COLLECTIONS(
+        out_buf.begin() + offset, out_buf.end(), expected.begin(), expected.end());
+
+    // In place
+    descrambler.descramble(in_buf.data() + offset);
+    BOOST_CHECK_EQUAL_COLLECTIONS(
+        in_buf.begin() + offset, in_buf.end(), expected.begin(), expected.end());
+
+    // Descrambling again recovers the scrambled BBFRAME
+    descrambler.descramble(in_buf.data() + offset);
+    BOOST_CHECK_EQUAL_COLLECTIONS(
+        in_buf.begin() + offset, in_buf.end(), scrambled.begin(), scrambled.end());
+}
+
+} // namespace dvbs2rx
+} // namespace gr
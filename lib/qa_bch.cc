@@ -8,6 +8,8 @@
  */
 
 #include "bch.h"
+#include "worker_pool.h"
+#include <bitset>
 #include <boost/mpl/list.hpp>
 #include <boost/mpl/pair.hpp>
 #include <boost/test/data/test_case.hpp>
@@ -688,6 +690,14 @@ void test_dvbs2(const std::string& fecframe_size, uint32_t n, uint8_t t)
     BOOST_CHECK_EQUAL_COLLECTIONS(
         msg.begin(), msg.end(), decoded_msg.begin(), decoded_msg.end());
     BOOST_CHECK_EQUAL(n_corrected, t);
+
+    // The allocation-free decoding should produce the same results
+    bch_workspace_t<uint32_t, bitset256_t> ws;
+    u8_vector_t decoded_msg_ws(k_bytes);
+    int n_corrected_ws = codec.decode(codeword.data(), decoded_msg_ws.data(), ws);
+    BOOST_CHECK_EQUAL_COLLECTIONS(
+        msg.begin(), msg.end(), decoded_msg_ws.begin(), decoded_msg_ws.end());
+    BOOST_CHECK_EQUAL(n_corrected_ws, t);
 }
 
 BOOST_AUTO_TEST_CASE(test_bch_dvbs2_encode_decode)
@@ -746,5 +756,223 @@ BOOST_AUTO_TEST_CASE(test_bch_dvbs2_encode_decode)
     }
 }
 
+/**
+ * @brief Encode random messages into consecutive codewords with random bit errors.
+ *
+ * @param codec BCH codec.
+ * @param n_codewords Number of codewords.
+ * @param n_errors_fn Function returning the number of bit errors of the i-th codeword.
+ * @param msgs Resulting messages, with k/8 bytes each.
+ * @param codewords Resulting codewords, with n/8 bytes each.
+ */
+template <typename T, typename P, typename F>
+void make_noisy_codewords(const bch_codec<T, P>& codec,
+                          uint32_t n_codewords,
+                          F n_errors_fn,
+                          u8_vector_t& msgs,
+                          u8_vector_t& codewords)
+{
+    uint32_t k_bytes = codec.get_k() / 8;
+    uint32_t n_bytes = codec.get_n() / 8;
+    msgs.resize(n_codewords * k_bytes);
+    codewords.resize(n_codewords * n_bytes);
+    fill_random_bytes(msgs);
+    for (uint32_t i = 0; i < n_codewords; i++) {
+        u8_vector_t codeword(n_bytes);
+        codec.encode(msgs.data() + i * k_bytes, codeword.data());
+        flip_random_bits(codeword, n_errors_fn(i));
+        std::copy(codeword.begin(), codeword.end(), codewords.begin() + i * n_bytes);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_bch_dvbs2_batch_decode)
+{
+    // DVB-S2 Normal 1/2 and Short 1/2 codes
+    const auto params_table = std::vector<std::tuple<uint32_t, uint32_t, uint8_t>>{
+        { 0b10000000000101101, 32400, 12 }, { 0b100000000101011, 7200, 12 }
+    };
+    for (const auto& params : params_table) {
+        gf2_poly_u32 prim_poly(std::get<0>(params));
+        galois_field gf(prim_poly);
+        const uint8_t t = std::get<2>(params);
+        bch_codec<uint32_t, bitset256_t> codec(&gf, t, std::get<1>(params));
+        uint32_t k_bytes = codec.get_k() / 8;
+        uint32_t n_bytes = codec.get_n() / 8;
+
+        // Consecutive codewords with 0 to t + 1 errors, such that the batch has a length
+        // that is not a multiple of the number of interleaved codewords and contains
+        // error-free, correctable and uncorrectable codewords.
+        const uint32_t n_codewords = t + 2;
+        u8_vector_t msgs, codewords;
+        make_noisy_codewords(
+            codec, n_codewords, [](uint32_t i) { return i; }, msgs, codewords);
+
+        // The batched syndromes and decoding results should match the ones obtained
+        // when processing one codeword at a time.
+        const auto syndromes = codec.syndrome(codewords.data(), n_codewords);
+        BOOST_CHECK_EQUAL(syndromes.size(), n_codewords);
+        BOOST_CHECK_EQUAL(syndromes[0].size(), 0);
+        bch_workspace_t<uint32_t, bitset256_t> ws;
+        u8_vector_t decoded_msgs(n_codewords * k_bytes);
+        std::vector<int> corrections(n_codewords);
+        codec.decode(
+            codewords.data(), decoded_msgs.data(), n_codewords, corrections.data(), ws);
+        for (uint32_t i = 0; i < n_codewords; i++) {
+            u8_cptr_t codeword = codewords.data() + i * n_bytes;
+            BOOST_CHECK(syndromes[i] == codec.syndrome(codeword));
+            u8_vector_t decoded_msg(k_bytes);
+            BOOST_CHECK_EQUAL(corrections[i], codec.decode(codeword, decoded_msg.data()));
+            BOOST_CHECK(std::equal(decoded_msg.begin(),
+                                   decoded_msg.end(),
+                                   decoded_msgs.begin() + i * k_bytes));
+            if (i <= t) {
+                BOOST_CHECK_EQUAL(corrections[i], static_cast<int>(i));
+                BOOST_CHECK(std::equal(decoded_msg.begin(),
+                                       decoded_msg.end(),
+                                       msgs.begin() + i * k_bytes));
+            }
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_bch_zero_copy_decode)
+{
+    // DVB-S2 Normal 1/2 code
+    gf2_poly_u32 prim_poly(0b10000000000101101);
+    galois_field gf(prim_poly);
+    const uint8_t t = 12;
+    bch_codec<uint32_t, bitset256_t> codec(&gf, t, 32400);
+    uint32_t k_bytes = codec.get_k() / 8;
+    uint32_t n_bytes = codec.get_n() / 8;
+
+    // Alternate error-free codewords with codewords having 1 to t + 1 errors
+    const uint32_t n_codewords = 2 * (t + 1);
+    u8_vector_t msgs, codewords;
+    make_noisy_codewords(
+        codec,
+        n_codewords,
+        [](uint32_t i) { return (i % 2) ? (i + 1) / 2 : 0; },
+        msgs,
+        codewords);
+
+    // The error-free messages should point to the codewords themselves, and the decoded
+    // messages and corrections should match the regular batched decoding.
+    bch_workspace_t<uint32_t, bitset256_t> ws;
+    std::vector<u8_cptr_t> decoded_msgs(n_codewords);
+    std::vector<int> corrections(n_codewords);
+    codec.decode_zero_copy(
+        codewords.data(), n_codewords, decoded_msgs.data(), corrections.data(), ws);
+
+    bch_workspace_t<uint32_t, bitset256_t> ref_ws;
+    u8_vector_t expected_msgs(n_codewords * k_bytes);
+    std::vector<int> expected_corrections(n_codewords);
+    codec.decode(codewords.data(),
+                 expected_msgs.data(),
+                 n_codewords,
+                 expected_corrections.data(),
+                 ref_ws);
+    for (uint32_t i = 0; i < n_codewords; i++) {
+        u8_cptr_t codeword = codewords.data() + i * n_bytes;
+        BOOST_CHECK_EQUAL(corrections[i], expected_corrections[i]);
+        BOOST_CHECK_EQUAL(decoded_msgs[i] == codeword, i % 2 == 0);
+        BOOST_CHECK(std::equal(decoded_msgs[i],
+                               decoded_msgs[i] + k_bytes,
+                               expected_msgs.begin() + i * k_bytes));
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_bch_workspace_decode)
+{
+    // DVB-S2 Short 1/2, 2/3 and 8/9 codes (t = 12) plus a GF(2^6) code with t = 4
+    const auto params_table = std::vector<std::tuple<uint32_t, uint32_t, uint8_t>>{
+        { 0b100000000101011, 7200, 12 },
+        { 0b100000000101011, 10800, 12 },
+        { 0b100000000101011, 14400, 12 },
+        { 0b1000011, 56, 4 }
+    };
+    std::mt19937 gen(0);
+    for (const auto& params : params_table) {
+        gf2_poly_u32 prim_poly(std::get<0>(params));
+        galois_field gf(prim_poly);
+        const uint8_t t = std::get<2>(params);
+        bch_codec<uint32_t, bitset256_t> codec(&gf, t, std::get<1>(params));
+        bch_workspace_t<uint32_t, bitset256_t> ws;
+        uint32_t k_bytes = codec.get_k() / 8;
+        uint32_t n_bytes = codec.get_n() / 8;
+
+        // The allocation-free decoding should match the original decoding for any number
+        // of errors, including uncorrectable error patterns. Reuse the same workspace
+        // across all codewords.
+        u8_vector_t msg(k_bytes);
+        u8_vector_t codeword(n_bytes);
+        u8_vector_t decoded_msg(k_bytes);
+        u8_vector_t decoded_msg_ws(k_bytes);
+        for (int trial = 0; trial < 50; trial++) {
+            for (auto& byte : msg)
+                byte = gen();
+            codec.encode(msg.data(), codeword.data());
+            flip_random_bits(codeword, trial % (t + 4));
+            int n_corrected = codec.decode(codeword.data(), decoded_msg.data());
+            int n_corrected_ws = codec.decode(codeword.data(), decoded_msg_ws.data(), ws);
+            BOOST_CHECK_EQUAL(n_corrected_ws, n_corrected);
+            BOOST_CHECK_EQUAL_COLLECTIONS(decoded_msg.begin(),
+                                          decoded_msg.end(),
+                                          decoded_msg_ws.begin(),
+                                          decoded_msg_ws.end());
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_bch_concurrent_decode)
+{
+    // DVB-S2 Normal 1/2 code
+    gf2_poly_u32 prim_poly(0b10000000000101101);
+    galois_field gf(prim_poly);
+    const uint8_t t = 12;
+    bch_codec<uint32_t, bitset256_t> codec(&gf, t, 32400);
+    uint32_t k_bytes = codec.get_k() / 8;
+    uint32_t n_bytes = codec.get_n() / 8;
+
+    const uint32_t n_codewords = 64;
+    u8_vector_t msgs, codewords;
+    make_noisy_codewords(
+        codec, n_codewords, [t](uint32_t i) { return i % (t + 2); }, msgs, codewords);
+
+    // Decode chunks of codewords concurrently, as in the BCH decoder block, with one
+    // workspace per worker. The results should match the serial decoding.
+    const unsigned int n_workers = 4;
+    const uint32_t n_chunks = 4 * n_workers;
+    worker_pool pool(n_workers);
+    std::vector<bch_workspace_t<uint32_t, bitset256_t>> workspaces(n_workers);
+    u8_vector_t decoded_msgs(n_codewords * k_bytes);
+    std::vector<int> corrections(n_codewords);
+    pool.parallel_for(n_chunks, [&](size_t i_chunk, unsigned int i_worker) {
+        const uint32_t start = (n_codewords * i_chunk) / n_chunks;
+        const uint32_t end = (n_codewords * (i_chunk + 1)) / n_chunks;
+        codec.decode(codewords.data() + start * n_bytes,
+                     decoded_msgs.data() + start * k_bytes,
+                     end - start,
+                     corrections.data() + start,
+                     workspaces[i_worker]);
+    });
+
+    bch_workspace_t<uint32_t, bitset256_t> ws;
+    u8_vector_t expected_msgs(n_codewords * k_bytes);
+    std::vector<int> expected_corrections(n_codewords);
+    codec.decode(codewords.data(),
+                 expected_msgs.data(),
+                 n_codewords,
+                 expected_corrections.data(),
+                 ws);
+    BOOST_CHECK_EQUAL_COLLECTIONS(corrections.begin(),
+                                  corrections.end(),
+                                  expected_corrections.begin(),
+                                  expected_corrections.end());
+    BOOST_CHECK_EQUAL_COLLECTIONS(decoded_msgs.begin(),
+                                  decoded_msgs.end(),
+                                  expected_msgs.begin(),
+                                  expected_msgs.end());
+}
+
 } // namespace dvbs2rx
-} // namespace gr
\ No newline at end of file
+} // namespace gr
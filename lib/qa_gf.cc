@@ -11,6 +11,8 @@
 #include <boost/mpl/list.hpp>
 #include <boost/test/data/test_case.hpp>
 #include <boost/test/unit_test.hpp>
+#include <bitset>
+#include <random>
 #include <set>
 
 namespace gr {
@@ -101,6 +103,25 @@ BOOST_AUTO_TEST_CASE_TEMPLATE(test_gf2m_multiplication, T, gf_elem_types)
     }
 }
 
+BOOST_AUTO_TEST_CASE_TEMPLATE(test_gf2m_multiplication_all_pairs, T, gf_elem_types)
+{
+    gf2_poly<T> prim_poly(0b10011); // x^4 + x + 1
+    galois_field gf(prim_poly);
+
+    // Compare the LUT-based product against the schoolbook product of the two elements
+    // as polynomials over GF(2) reduced modulo the primitive polynomial. Cover all pairs,
+    // including the zero element and the exponent sums that wrap around 2^m - 1.
+    for (uint32_t a = 0; a < 16; a++) {
+        for (uint32_t b = 0; b < 16; b++) {
+            const auto prod = gf2_poly<T>(a) * gf2_poly<T>(b);
+            const T expected_res = (prod % prim_poly).get_poly();
+            BOOST_CHECK_EQUAL(gf.multiply(a, b), expected_res);
+            if (b != 0)
+                BOOST_CHECK_EQUAL(gf.divide(expected_res, b), a);
+        }
+    }
+}
+
 BOOST_AUTO_TEST_CASE_TEMPLATE(test_gf2m_inverse, T, gf_elem_types)
 {
     gf2_poly<T> prim_poly(0b10011); // x^4 + x + 1
@@ -369,6 +390,52 @@ BOOST_AUTO_TEST_CASE_TEMPLATE(test_gf2_poly_remainder, T, gf2_poly_base_types)
     BOOST_CHECK_THROW(d % zero_poly, std::runtime_error);
 }
 
+BOOST_AUTO_TEST_CASE(test_bitset256_ops)
+{
+    // The word-based bitset256_t should match std::bitset<256> bit by bit
+    std::mt19937_64 gen(0);
+    auto to_ref = [](const bitset256_t& x) {
+        std::bitset<256> ref;
+        for (size_t i = 0; i < 256; i++)
+            ref[i] = x[i];
+        return ref;
+    };
+    auto random_bitset = [&gen](int n_bits) {
+        bitset256_t x;
+        for (int w = 0; w < 4; w++)
+            x = (x << 64) ^ bitset256_t(gen());
+        return (n_bits < 256) ? (x & ~(~bitset256_t() << n_bits)) : x;
+    };
+
+    for (int n_bits = 0; n_bits <= 256; n_bits += 5) {
+        const bitset256_t a = random_bitset(n_bits);
+        const bitset256_t b = random_bitset(256);
+        const auto a_ref = to_ref(a);
+        const auto b_ref = to_ref(b);
+        BOOST_CHECK(to_ref(a ^ b) == (a_ref ^ b_ref));
+        BOOST_CHECK(to_ref(a & b) == (a_ref & b_ref));
+        BOOST_CHECK(to_ref(a | b) == (a_ref | b_ref));
+        BOOST_CHECK(to_ref(~a) == ~a_ref);
+        for (size_t shift : { 0, 1, 7, 8, 63, 64, 65, 127, 128, 200, 255, 256, 300 }) {
+            BOOST_CHECK(to_ref(a << shift) == (a_ref << shift));
+            BOOST_CHECK(to_ref(a >> shift) == (a_ref >> shift));
+        }
+
+        // Most significant bit set and polynomial degree
+        int expected_msb = -1;
+        for (int i = 255; i >= 0 && expected_msb < 0; i--)
+            if (a_ref[i])
+                expected_msb = i;
+        BOOST_CHECK_EQUAL(a.msb_index(), expected_msb);
+        BOOST_CHECK_EQUAL(gf2_poly<bitset256_t>(a).degree(), expected_msb);
+        BOOST_CHECK_EQUAL(a.any(), a_ref.any());
+        BOOST_CHECK(a == a && (a != b) == (a_ref != b_ref));
+    }
+
+    BOOST_CHECK_EQUAL(bitset256_t(0x1234).to_ulong(), 0x1234UL);
+    BOOST_CHECK_THROW((bitset256_t(1) << 100).to_ulong(), std::overflow_error);
+}
+
 BOOST_AUTO_TEST_CASE_TEMPLATE(test_gf2_poly_to_gf2m_poly, T, gf_elem_types)
 {
     gf2_poly<T> prim_poly(0b10011); // x^4 + x + 1
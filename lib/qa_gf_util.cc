@@ -11,6 +11,7 @@
 #include <boost/mpl/list.hpp>
 #include <boost/test/data/test_case.hpp>
 #include <boost/test/unit_test.hpp>
+#include <random>
 
 namespace gr {
 namespace dvbs2rx {
@@ -95,6 +96,96 @@ BOOST_AUTO_TEST_CASE_TEMPLATE(test_remainder, T, gf2_poly_base_types)
     }
 }
 
+typedef boost::mpl::list<uint16_t, uint32_t, uint64_t, bitset256_t> gf2_poly_rem_types;
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(test_remainder_batch, T, gf2_poly_rem_types)
+{
+    // The batched remainder computation should match the byte-by-byte computation for
+    // divisors of any degree supported by type T and for dividends of any size.
+    std::mt19937 gen(0);
+    std::uniform_int_distribution<> dis(0, 255);
+    const int max_degree = (sizeof(T) - 1) * 8;
+    for (int degree = 1; degree <= max_degree; degree += (degree < 10) ? 1 : 7) {
+        T g_coefs = static_cast<T>(1) << degree;
+        for (int i = 0; i < degree; i++)
+            if (dis(gen) & 1)
+                g_coefs ^= static_cast<T>(1) << i;
+        gf2_poly<T> g(g_coefs);
+        auto rem_lut = build_gf2_poly_rem_lut(g);
+        auto rem_word_lut = build_gf2_poly_rem_word_lut(g);
+
+        for (int y_size : { 1, 2, 5, 33, 100 }) {
+            const int n_polys = 7; // one group of interleaved dividends plus leftovers
+            u8_vector_t y(n_polys * y_size);
+            for (auto& byte : y)
+                byte = dis(gen);
+            std::vector<gf2_poly<T>> rem(n_polys, gf2_poly<T>(0));
+            gf2_poly_rem_batch(y.data(), y_size, n_polys, g, rem_word_lut, rem.data());
+            for (int j = 0; j < n_polys; j++) {
+                u8_cptr_t y_j = y.data() + j * y_size;
+                BOOST_CHECK(rem[j] == gf2_poly_rem(y_j, y_size, g, rem_lut));
+            }
+        }
+    }
+}
+
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(test_remainder_slice, T, gf2_poly_rem_types)
+{
+    // The slice-by-N remainder computation should match the byte-by-byte computation
+    // for divisors of any degree supported by type T and for dividends of any size.
+    std::mt19937 gen(0);
+    std::uniform_int_distribution<> dis(0, 255);
+    const int max_degree = (sizeof(T) - 1) * 8;
+    for (int degree = 1; degree <= max_degree; degree += (degree < 10) ? 1 : 7) {
+        T g_coefs = static_cast<T>(1) << degree;
+        for (int i = 0; i < degree; i++)
+            if (dis(gen) & 1)
+                g_coefs ^= static_cast<T>(1) << i;
+        gf2_poly<T> g(g_coefs);
+        auto rem_lut = build_gf2_poly_rem_lut(g);
+        for (int n_slices : { 4, 8 }) {
+            auto rem_slice_lut = build_gf2_poly_rem_slice_lut(g, n_slices);
+            for (int y_size : { 1, 2, 5, 33, 100, 101 }) {
+                u8_vector_t y(y_size);
+                for (auto& byte : y)
+                    byte = dis(gen);
+                BOOST_CHECK(gf2_poly_rem_slice(y.data(), y_size, g, rem_slice_lut) ==
+                            gf2_poly_rem(y, g, rem_lut));
+            }
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(test_remainder_clmul, T, gf2_poly_rem_types)
+{
+    if (!gf2_clmul_supported())
+        return;
+
+    // The remainder computed by folding should match the byte-by-byte computation for
+    // divisors of degree up to 192 and for dividends of any size.
+    std::mt19937 gen(0);
+    std::uniform_int_distribution<> dis(0, 255);
+    const int max_degree = std::min<int>((sizeof(T) - 1) * 8, 192);
+    for (int degree = 1; degree <= max_degree; degree += (degree < 10) ? 1 : 7) {
+        T g_coefs = static_cast<T>(1) << degree;
+        for (int i = 0; i < degree; i++)
+            if (dis(gen) & 1)
+                g_coefs ^= static_cast<T>(1) << i;
+        gf2_poly<T> g(g_coefs);
+        auto rem_lut = build_gf2_poly_rem_lut(g);
+        auto rem_word_lut = build_gf2_poly_rem_word_lut(g);
+        auto rem_clmul_consts = build_gf2_poly_rem_clmul_consts(g);
+        for (int y_size : { 1, 2, 5, 16, 33, 100, 7200 }) {
+            u8_vector_t y(y_size);
+            for (auto& byte : y)
+                byte = dis(gen);
+            BOOST_CHECK(gf2_poly_rem_clmul(
+                            y.data(), y_size, g, rem_clmul_consts, rem_word_lut) ==
+                        gf2_poly_rem(y, g, rem_lut));
+        }
+    }
+}
 
 } // namespace dvbs2rx
 } // namespace gr
\ No newline at end of file
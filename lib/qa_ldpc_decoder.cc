@@ -0,0 +1,432 @@
+/* -*- c++ -*- */
+/*
+ * Copyright (c) 2024 Igor Freire.
+ *
+ * This file is part of gr-dvbs2rx.
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#include "cpu_features_macros.h"
+#include "dvb_s2_tables.hh"
+#include "ldpc_decoder/ldpc_decoder_isa.hh"
+#include "ldpc_decoder/transpose.hh"
+#include <boost/test/unit_test.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <memory>
+#include <random>
+#include <vector>
+
+#ifdef CPU_FEATURES_ARCH_ARM
+#include "cpuinfo_arm.h"
+using namespace cpu_features;
+#endif
+
+#ifdef CPU_FEATURES_ARCH_X86
+#include "cpuinfo_x86.h"
+using namespace cpu_features;
+#endif
+
+namespace gr {
+namespace dvbs2rx {
+
+namespace {
+
+typedef void* (*ldpc_create_t)(LDPCInterface*, const ldpc_min_sum_t&);
+typedef void (*ldpc_destroy_t)(void*);
+typedef int (*ldpc_decode_t)(void*, void*, int8_t*, int, int);
+typedef int (*ldpc_decode_stream_t)(void*, void*, const int8_t*, int8_t*, int, int, int*);
+
+// LDPC decoder variant (schedule and precision)
+struct ldpc_variant_t {
+    const char* name;
+    int batch_size; // frames per batch decoded by "decode"
+    ldpc_create_t create;
+    ldpc_destroy_t destroy;
+    ldpc_decode_t decode;
+    ldpc_decode_stream_t decode_stream;
+};
+
+// LDPC decoder implementation under test
+struct ldpc_isa_t {
+    const char* name;
+    int simd_size;
+    bool (*supported)();
+    std::vector<ldpc_variant_t> variants;
+    void (*pack)(const int8_t*, uint8_t*, int);
+};
+
+// Entry points of the implementation on a given namespace
+#define LDPC_ISA(ns, name, simd_size, supported)                                      \
+    {                                                                                 \
+        name, simd_size, supported,                                                   \
+            { { "layered",                                                            \
+                simd_size,                                                            \
+                ns::ldpc_dec_create,                                                  \
+                ns::ldpc_dec_destroy,                                                 \
+                ns::ldpc_dec_decode,                                                  \
+                ns::ldpc_dec_decode_stream },                                         \
+              { "flooding",                                                           \
+                simd_size,                                                            \
+                ns::ldpc_dec_create_flooding,                                         \
+                ns::ldpc_dec_destroy_flooding,                                        \
+                ns::ldpc_dec_decode_flooding,                                         \
+                ns::ldpc_dec_decode_stream_flooding },                                \
+              { "int16",                                                              \
+                simd_size / 2,                                                        \
+                ns::ldpc_dec_create_int16,                                            \
+                ns::ldpc_dec_destroy_int16,                                           \
+                ns::ldpc_dec_decode_int16,                                            \
+                ns::ldpc_dec_decode_stream_int16 } },                                 \
+            ns::ldpc_dec_pack                                                         \
+    }
+
+bool always() { return true; }
+
+#ifdef CPU_FEATURES_ARCH_X86
+bool has_sse41() { return GetX86Info().features.sse4_1; }
+bool has_avx2() { return GetX86Info().features.avx2; }
+bool has_avx512bw() { return GetX86Info().features.avx512bw; }
+#endif
+
+#ifdef CPU_FEATURES_ARCH_ANY_ARM
+#ifdef CPU_FEATURES_ARCH_AARCH64
+bool has_neon() { return true; } // always available on aarch64
+#else
+bool has_neon() { return GetArmInfo().features.neon; }
+#endif
+#endif
+
+// Implementations supported by the CPU running the tests
+std::vector<ldpc_isa_t> supported_isas()
+{
+    std::vector<ldpc_isa_t> isas = { LDPC_ISA(ldpc_generic, "generic", 16, always) };
+#ifdef CPU_FEATURES_ARCH_X86
+    isas.push_back(LDPC_ISA(ldpc_sse41, "sse41", 16, has_sse41));
+    isas.push_back(LDPC_ISA(ldpc_avx2, "avx2", 32, has_avx2));
+    isas.push_back(LDPC_ISA(ldpc_avx512, "avx512", 64, has_avx512bw));
+#endif
+#ifdef CPU_FEATURES_ARCH_ANY_ARM
+    isas.push_back(LDPC_ISA(ldpc_neon, "neon", 16, has_neon));
+#endif
+    isas.erase(std::remove_if(isas.begin(),
+                              isas.end(),
+                              [](const ldpc_isa_t& isa) { return !isa.supported(); }),
+               isas.end());
+    return isas;
+}
+
+struct ldpc_test_code_t {
+    const char* name;
+    std::shared_ptr<LDPCInterface> code;
+    double esn0_db; // Es/N0 comfortably above the convergence threshold
+};
+
+// Short FECFRAME rates 1/2 and 8/9, i.e., a code with many low-degree check nodes and
+// another with few high-degree check nodes
+std::vector<ldpc_test_code_t> test_codes()
+{
+    return {
+        { "short_1/2", std::make_shared<LDPC<DVB_S2_TABLE_C4>>(), 2 },
+        { "short_8/9", std::make_shared<LDPC<DVB_S2_TABLE_C10>>(), 6 },
+    };
+}
+
+// Check node update rules supported by the decoder block
+const ldpc_min_sum_t min_sum_rules[] = {
+    { 1.0f, 1.0f, false },   // offset
+    { 0.0f, 0.875f, false }, // normalized
+    { 1.0f, 1.0f, true },    // self-corrected
+};
+
+/**
+ * @brief Encode random messages into DVB-S2 LDPC codewords.
+ *
+ * Each information bit is accumulated on the parity bits given by the code table, and
+ * the parity bits are then accumulated on each other, as on Section 5.3.2 of the
+ * standard.
+ *
+ * @param code LDPC code.
+ * @param frames Number of codewords.
+ * @param rng Random number generator.
+ * @return std::vector<uint8_t> Codeword bits, one per byte, frame after frame.
+ */
+std::vector<uint8_t> encode(LDPCInterface* code, int frames, std::mt19937& rng)
+{
+    const int n = code->code_len();
+    const int k = code->data_len();
+    std::vector<uint8_t> bits(frames * n, 0);
+    for (int f = 0; f < frames; f++) {
+        uint8_t* codeword = bits.data() + f * n;
+        uint8_t* parity = codeword + k;
+        code->first_bit();
+        for (int i = 0; i < k; i++) {
+            codeword[i] = rng() & 1;
+            if (codeword[i]) {
+                const int* acc_pos = code->acc_pos();
+                for (int j = 0; j < code->bit_deg(); j++)
+                    parity[acc_pos[j]] ^= 1;
+            }
+            code->next_bit();
+        }
+        for (int i = 1; i < n - k; i++)
+            parity[i] ^= parity[i - 1];
+    }
+    return bits;
+}
+
+/**
+ * @brief Generate int8 LLRs for BPSK-modulated codewords over AWGN.
+ *
+ * @param bits Codeword bits.
+ * @param esn0_db Es/N0 in dB, or infinity for noise-free LLRs with random magnitudes.
+ * @param rng Random number generator.
+ * @return std::vector<int8_t> LLRs, positive for bit 0 and negative for bit 1.
+ */
+std::vector<int8_t>
+gen_llrs(const std::vector<uint8_t>& bits, double esn0_db, std::mt19937& rng)
+{
+    std::vector<int8_t> llr(bits.size());
+    if (std::isinf(esn0_db)) {
+        std::uniform_int_distribution<int> mag(1, 127);
+        for (size_t i = 0; i < bits.size(); i++)
+            llr[i] = bits[i] ? -mag(rng) : mag(rng);
+        return llr;
+    }
+    const double sigma2 = 1.0 / (2 * std::pow(10.0, esn0_db / 10));
+    std::normal_distribution<double> noise(0.0, std::sqrt(sigma2));
+    for (size_t i = 0; i < bits.size(); i++) {
+        const double y = (bits[i] ? -1.0 : 1.0) + noise(rng);
+        const double l = std::nearbyint(2 * y / sigma2);
+        llr[i] = static_cast<int8_t>(std::min(std::max(l, -127.0), 127.0));
+    }
+    return llr;
+}
+
+// Number of hard decisions on "llr" that differ from "bits"
+int count_bit_errors(const std::vector<uint8_t>& bits, const int8_t* llr, int n_bits)
+{
+    int errors = 0;
+    for (int i = 0; i < n_bits; i++)
+        errors += (llr[i] < 0) != (bits[i] != 0);
+    return errors;
+}
+
+// Aligned buffer for the decoders' working memory, "bytes" long per SIMD lane
+struct ldpc_buffer_t {
+    void* ptr;
+    ldpc_buffer_t(int simd_size, int bytes)
+        : ptr(aligned_alloc(simd_size, simd_size * bytes))
+    {
+    }
+    ~ldpc_buffer_t() { free(ptr); }
+};
+
+} // namespace
+
+// Noise-free LLRs pass the parity checks before any decoding iteration, so every
+// decoder should return them untouched with all trials left. This checks the
+// transpositions between the serial frames and the SIMD lanes, including the partial
+// groups of lanes handled one by one and the lanes kept busy by other frames.
+BOOST_AUTO_TEST_CASE(test_ldpc_noise_free)
+{
+    const int max_trials = 25;
+    std::mt19937 rng(0);
+    for (const auto& isa : supported_isas()) {
+        for (const auto& code : test_codes()) {
+            const int n = code.code->code_len();
+            const int max_frames = 2 * isa.simd_size + 5;
+            const auto bits = encode(code.code.get(), max_frames, rng);
+            const auto llr = gen_llrs(bits, INFINITY, rng);
+            ldpc_buffer_t buffer(isa.simd_size, n);
+            for (const auto& variant : isa.variants) {
+                BOOST_TEST_CONTEXT(isa.name << "/" << code.name << "/" << variant.name)
+                {
+                    void* dec = variant.create(code.code.get(), ldpc_min_sum_t());
+
+                    std::vector<int8_t> soft(llr.begin(),
+                                             llr.begin() + variant.batch_size * n);
+                    const int count = variant.decode(
+                        dec, buffer.ptr, soft.data(), max_trials, variant.batch_size);
+                    BOOST_CHECK_EQUAL(count, max_trials);
+                    BOOST_CHECK(std::equal(soft.begin(), soft.end(), llr.begin()));
+
+                    for (int frames : { 1, 3, 4, variant.batch_size, max_frames }) {
+                        std::vector<int8_t> out(frames * n);
+                        std::vector<int> counts(frames);
+                        variant.decode_stream(dec,
+                                              buffer.ptr,
+                                              llr.data(),
+                                              out.data(),
+                                              max_trials,
+                                              frames,
+                                              counts.data());
+                        BOOST_CHECK(std::equal(out.begin(), out.end(), llr.begin()));
+                        for (int i = 0; i < frames; i++)
+                            BOOST_CHECK_EQUAL(counts[i], max_trials);
+                    }
+
+                    variant.destroy(dec);
+                }
+            }
+        }
+    }
+}
+
+// Every decoder should correct the noisy codewords with every check node update rule.
+// The streams decoded with lane recycling should reach the same hard decisions as the
+// batches decoded in place, both out of place and in place.
+BOOST_AUTO_TEST_CASE(test_ldpc_noisy)
+{
+    const int max_trials = 25;
+    std::mt19937 rng(1);
+    for (const auto& isa : supported_isas()) {
+        for (const auto& code : test_codes()) {
+            const int n = code.code->code_len();
+            const int frames = 2 * isa.simd_size + 5;
+            const auto bits = encode(code.code.get(), frames, rng);
+            const auto llr = gen_llrs(bits, code.esn0_db, rng);
+            BOOST_REQUIRE_GT(count_bit_errors(bits, llr.data(), frames * n), 0);
+            ldpc_buffer_t buffer(isa.simd_size, n);
+            for (const auto& variant : isa.variants) {
+                for (const auto& min_sum : min_sum_rules) {
+                    BOOST_TEST_CONTEXT(isa.name << "/" << code.name << "/"
+                                                << variant.name << "/offset:"
+                                                << min_sum.offset << "/factor:"
+                                                << min_sum.factor << "/self_corrected:"
+                                                << min_sum.self_corrected)
+                    {
+                        void* dec = variant.create(code.code.get(), min_sum);
+
+                        // Batch decoding of the first frames as the reference
+                        std::vector<int8_t> batch(llr.begin(),
+                                                  llr.begin() + variant.batch_size * n);
+                        const int count = variant.decode(dec,
+                                                         buffer.ptr,
+                                                         batch.data(),
+                                                         max_trials,
+                                                         variant.batch_size);
+                        BOOST_CHECK_GE(count, 0);
+                        BOOST_CHECK_EQUAL(
+                            count_bit_errors(bits, batch.data(), batch.size()), 0);
+
+                        // Stream decoding
+                        std::vector<int8_t> out(llr.size());
+                        std::vector<int> counts(frames);
+                        variant.decode_stream(dec,
+                                              buffer.ptr,
+                                              llr.data(),
+                                              out.data(),
+                                              max_trials,
+                                              frames,
+                                              counts.data());
+                        for (int i = 0; i < frames; i++)
+                            BOOST_CHECK_GE(counts[i], 0);
+                        BOOST_CHECK_EQUAL(count_bit_errors(bits, out.data(), out.size()),
+                                          0);
+                        int mismatches = 0;
+                        for (size_t i = 0; i < batch.size(); i++)
+                            mismatches += (batch[i] < 0) != (out[i] < 0);
+                        BOOST_CHECK_EQUAL(mismatches, 0);
+
+                        // In-place stream decoding
+                        std::vector<int8_t> in_place(llr);
+                        variant.decode_stream(dec,
+                                              buffer.ptr,
+                                              in_place.data(),
+                                              in_place.data(),
+                                              max_trials,
+                                              frames,
+                                              counts.data());
+                        BOOST_CHECK(
+                            std::equal(in_place.begin(), in_place.end(), out.begin()));
+
+                        variant.destroy(dec);
+                    }
+                }
+            }
+        }
+    }
+}
+
+// The SIMD bit-packing of the hard decisions should match the scalar reference for any
+// number of bytes, including the tails shorter than a SIMD word.
+BOOST_AUTO_TEST_CASE(test_ldpc_pack)
+{
+    std::mt19937 rng(2);
+    std::uniform_int_distribution<int> dist(-128, 127);
+    for (const auto& isa : supported_isas()) {
+        for (int bytes : { 1, 2, 7, 8, 15, 16, 17, 31, 32, 33, 63, 64, 65, 2025, 8100 }) {
+            BOOST_TEST_CONTEXT(isa.name << "/bytes:" << bytes)
+            {
+                std::vector<int8_t> llr(8 * bytes);
+                for (auto& x : llr)
+                    x = dist(rng);
+                llr[0] = 0; // zero is a hard decision of bit 0
+                std::vector<uint8_t> expected(bytes, 0);
+                for (int j = 0; j < bytes; j++)
+                    for (int k = 0; k < 8; k++)
+                        if (llr[8 * j + k] < 0)
+                            expected[j] |= 1 << (7 - k);
+                // Guard byte after the output to catch writes past the end
+                std::vector<uint8_t> out(bytes + 1, 0xa5);
+                isa.pack(llr.data(), out.data(), bytes);
+                BOOST_CHECK_EQUAL_COLLECTIONS(
+                    out.begin(), out.end() - 1, expected.begin(), expected.end());
+                BOOST_CHECK_EQUAL(out[bytes], 0xa5);
+            }
+        }
+    }
+}
+
+// The 16x16 transposition kernels should only touch the rows and lanes selected on the
+// mask, and transposing back and forth should recover the original rows.
+BOOST_AUTO_TEST_CASE(test_ldpc_transpose)
+{
+    const int stride = 64; // SIMD word size in bytes
+    const int cols = 48;
+    std::mt19937 rng(3);
+    std::vector<std::vector<int8_t>> rows(16, std::vector<int8_t>(cols));
+    for (auto& row : rows)
+        for (auto& x : row)
+            x = rng();
+    const int8_t* src[16];
+    for (int r = 0; r < 16; r++)
+        src[r] = rows[r].data();
+
+    for (uint16_t mask : { 0xffff, 0x0001, 0x8000, 0x00f0, 0x5a5a, 0x7ffe }) {
+        for (int col : { 0, 16, 32 }) {
+            BOOST_TEST_CONTEXT("mask:" << mask << "/col:" << col)
+            {
+                const int8_t fill = 0x33;
+                std::vector<int8_t> words(16 * stride, fill);
+                transpose_rows_to_lanes(src, col, words.data(), stride, mask);
+                for (int c = 0; c < 16; c++) {
+                    for (int lane = 0; lane < stride; lane++) {
+                        const bool sel = lane < 16 && (mask >> lane & 1);
+                        const int8_t expected = sel ? rows[lane][col + c] : fill;
+                        BOOST_CHECK_EQUAL(words[c * stride + lane], expected);
+                    }
+                }
+
+                std::vector<std::vector<int8_t>> back(16,
+                                                      std::vector<int8_t>(cols, fill));
+                int8_t* dst[16];
+                for (int r = 0; r < 16; r++)
+                    dst[r] = back[r].data();
+                transpose_lanes_to_rows(words.data(), stride, dst, col, mask);
+                for (int r = 0; r < 16; r++) {
+                    for (int c = 0; c < cols; c++) {
+                        const bool sel = (mask >> r & 1) && c >= col && c < col + 16;
+                        BOOST_CHECK_EQUAL(back[r][c], sel ? rows[r][c] : fill);
+                    }
+                }
+            }
+        }
+    }
+}
+
+} // namespace dvbs2rx
+} // namespace gr
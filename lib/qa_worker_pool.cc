@@ -0,0 +1,88 @@
+/* -*- c++ -*- */
+/*
+ * Copyright (c) 2024 Igor Freire.
+ *
+ * This file is part of gr-dvbs2rx.
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#include "worker_pool.h"
+#include <boost/test/data/test_case.hpp>
+#include <boost/test/unit_test.hpp>
+#include <atomic>
+
+namespace bdata = boost::unit_test::data;
+
+namespace gr {
+namespace dvbs2rx {
+
+BOOST_AUTO_TEST_CASE(test_zero_workers)
+{
+    BOOST_CHECK_THROW(worker_pool pool(0), std::invalid_argument);
+}
+
+// Every task should run exactly once, and the results stored on task-indexed slots
+// should come out in order regardless of the number of workers.
+BOOST_DATA_TEST_CASE(test_parallel_for, bdata::make({ 1, 2, 4, 8 }), n_workers)
+{
+    worker_pool pool(n_workers);
+    BOOST_CHECK_EQUAL(pool.size(), n_workers);
+
+    // Run multiple jobs on the same pool to exercise the thread wake-up logic.
+    for (size_t n_tasks : { 0, 1, 3, 100, 1000 }) {
+        // Boost.Test assertions are not thread-safe, so record the results on the
+        // workers and check them afterwards.
+        std::vector<int> out(n_tasks, -1);
+        std::vector<unsigned int> worker(n_tasks);
+        std::vector<std::atomic<int>> run_cnt(n_tasks);
+        pool.parallel_for(n_tasks, [&](size_t i_task, unsigned int i_worker) {
+            out[i_task] = 2 * i_task;
+            worker[i_task] = i_worker;
+            run_cnt[i_task]++;
+        });
+        for (size_t i = 0; i < n_tasks; i++) {
+            BOOST_CHECK_EQUAL(out[i], 2 * i);
+            BOOST_CHECK_LT(worker[i], static_cast<unsigned int>(n_workers));
+            BOOST_CHECK_EQUAL(run_cnt[i], 1);
+        }
+    }
+}
+
+// The worker index should be usable to access per-worker state without locking.
+BOOST_DATA_TEST_CASE(test_per_worker_state, bdata::make({ 1, 3 }), n_workers)
+{
+    worker_pool pool(n_workers);
+    std::vector<size_t> acc(n_workers, 0);
+    const size_t n_tasks = 10000;
+    pool.parallel_for(n_tasks, [&](size_t i_task, unsigned int i_worker) {
+        acc[i_worker] += i_task;
+    });
+    size_t sum = 0;
+    for (auto x : acc)
+        sum += x;
+    BOOST_CHECK_EQUAL(sum, n_tasks * (n_tasks - 1) / 2);
+}
+
+// An exception thrown by a task on any worker should reach the caller, and the pool
+// should remain usable afterwards.
+BOOST_DATA_TEST_CASE(test_task_exception, bdata::make({ 1, 4 }), n_workers)
+{
+    worker_pool pool(n_workers);
+    const size_t n_tasks = 100;
+    for (size_t i_throw : { size_t(0), size_t(57), n_tasks - 1 }) {
+        BOOST_CHECK_THROW(pool.parallel_for(n_tasks,
+                                            [&](size_t i_task, unsigned int i_worker) {
+                                                if (i_task == i_throw)
+                                                    throw std::runtime_error("task");
+                                            }),
+                          std::runtime_error);
+    }
+
+    std::atomic<size_t> run_cnt(0);
+    pool.parallel_for(n_tasks, [&](size_t i_task, unsigned int i_worker) { run_cnt++; });
+    BOOST_CHECK_EQUAL(run_cnt, n_tasks);
+}
+
+} // namespace dvbs2rx
+} // namespace gr
@@ -0,0 +1,183 @@
+/* -*- c++ -*- */
+/*
+ * Copyright (c) 2024 Igor Freire.
+ *
+ * This file is part of gr-dvbs2rx.
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#ifndef INCLUDED_DVBS2RX_WORKER_POOL_H
+#define INCLUDED_DVBS2RX_WORKER_POOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace gr {
+namespace dvbs2rx {
+
+/**
+ * @brief Pool of worker threads for fork-join parallel processing
+ *
+ * Distributes a set of independent tasks among a fixed number of workers and blocks
+ * until all tasks are completed. The calling thread participates as worker 0, so a
+ * pool of size N spawns N - 1 threads, and a pool of size one runs all tasks inline.
+ *
+ * Each task function receives the task index and the index of the worker running it.
+ * The worker index is unique among the concurrently running tasks, so it can be used to
+ * access per-worker state (e.g., scratch buffers) without locking. Since each task is
+ * identified by its index, the caller can preserve the order of the results by storing
+ * them in task-indexed slots.
+ *
+ * An exception thrown by a task is caught on the worker running it and rethrown on the
+ * calling thread once all workers are done with the job.
+ */
+class worker_pool
+{
+public:
+    typedef std::function<void(size_t i_task, unsigned int i_worker)> task_fn_t;
+
+private:
+    const unsigned int d_n_workers;     /**< Number of workers including the caller */
+    std::vector<std::thread> d_threads; /**< Worker threads (all but worker 0) */
+    std::mutex d_mutex;
+    std::condition_variable d_cv_start; /**< Signals a new job to the threads */
+    std::condition_variable d_cv_done;  /**< Signals job completion to the caller */
+    const task_fn_t* d_task_fn;         /**< Task function of the current job */
+    size_t d_n_tasks;                   /**< Number of tasks on the current job */
+    std::atomic<size_t> d_next_task;    /**< Index of the next task to run */
+    unsigned int d_n_busy;              /**< Threads still running the current job */
+    uint64_t d_job_cnt;                 /**< Job counter */
+    bool d_stop;                        /**< Whether the threads should exit */
+    std::exception_ptr d_error;         /**< First exception thrown on the current job */
+
+    void run_tasks(unsigned int i_worker)
+    {
+        size_t i_task;
+        while ((i_task = d_next_task.fetch_add(1)) < d_n_tasks) {
+            try {
+                (*d_task_fn)(i_task, i_worker);
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(d_mutex);
+                if (!d_error)
+                    d_error = std::current_exception();
+                d_next_task = d_n_tasks; // skip the remaining tasks
+            }
+        }
+    }
+
+    void thread_loop(unsigned int i_worker)
+    {
+        uint64_t last_job = 0;
+        while (true) {
+            {
+                std::unique_lock<std::mutex> lock(d_mutex);
+                d_cv_start.wait(lock, [&] { return d_stop || d_job_cnt != last_job; });
+                if (d_stop)
+                    return;
+                last_job = d_job_cnt;
+            }
+            run_tasks(i_worker);
+            {
+                std::lock_guard<std::mutex> lock(d_mutex);
+                if (--d_n_busy == 0)
+                    d_cv_done.notify_one();
+            }
+        }
+    }
+
+public:
+    /**
+     * @brief Construct a new worker pool.
+     *
+     * @param n_workers Number of workers, including the calling thread.
+     * @throws std::invalid_argument if n_workers is zero.
+     */
+    explicit worker_pool(unsigned int n_workers)
+        : d_n_workers(n_workers),
+          d_task_fn(nullptr),
+          d_n_tasks(0),
+          d_next_task(0),
+          d_n_busy(0),
+          d_job_cnt(0),
+          d_stop(false)
+    {
+        if (n_workers == 0)
+            throw std::invalid_argument("The worker pool needs at least one worker");
+        for (unsigned int i = 1; i < n_workers; i++)
+            d_threads.emplace_back(&worker_pool::thread_loop, this, i);
+    }
+
+    ~worker_pool()
+    {
+        {
+            std::lock_guard<std::mutex> lock(d_mutex);
+            d_stop = true;
+        }
+        d_cv_start.notify_all();
+        for (auto& thread : d_threads)
+            thread.join();
+    }
+
+    worker_pool(const worker_pool&) = delete;
+    worker_pool& operator=(const worker_pool&) = delete;
+
+    /**
+     * @brief Get the number of workers, including the calling thread.
+     *
+     * @return unsigned int Number of workers.
+     */
+    unsigned int size() const { return d_n_workers; }
+
+    /**
+     * @brief Run tasks in parallel and wait until all of them are completed.
+     *
+     * @param n_tasks Number of tasks.
+     * @param task_fn Task function called with the task and worker indexes.
+     * @throws Any exception thrown by a task, in which case the tasks not started yet
+     * are skipped. If multiple tasks throw, only the first exception is rethrown.
+     * @note This function is not reentrant. It must be called by a single thread.
+     */
+    void parallel_for(size_t n_tasks, const task_fn_t& task_fn)
+    {
+        if (d_threads.empty() || n_tasks == 1) {
+            for (size_t i_task = 0; i_task < n_tasks; i_task++)
+                task_fn(i_task, 0);
+            return;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(d_mutex);
+            d_task_fn = &task_fn;
+            d_n_tasks = n_tasks;
+            d_next_task = 0;
+            d_n_busy = d_threads.size();
+            d_error = nullptr;
+            d_job_cnt++;
+        }
+        d_cv_start.notify_all();
+
+        run_tasks(0);
+
+        std::unique_lock<std::mutex> lock(d_mutex);
+        d_cv_done.wait(lock, [&] { return d_n_busy == 0; });
+        if (d_error) {
+            std::exception_ptr error = d_error;
+            d_error = nullptr;
+            lock.unlock();
+            std::rethrow_exception(error);
+        }
+    }
+};
+
+} // namespace dvbs2rx
+} // namespace gr
+
+#endif /* INCLUDED_DVBS2RX_WORKER_POOL_H */
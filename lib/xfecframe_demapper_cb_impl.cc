@@ -11,6 +11,11 @@
 #include <gnuradio/io_signature.h>
 #include <gnuradio/pdu.h>
 
+#ifdef CPU_FEATURES_ARCH_X86
+#include "cpuinfo_x86.h"
+using namespace cpu_features;
+#endif
+
 namespace gr {
 namespace dvbs2rx {
 
@@ -75,11 +80,19 @@ xfecframe_demapper_cb_impl::xfecframe_demapper_cb_impl(dvb_framesize_t framesize
     d_aux_8i_buffer.resize(d_fecframe_len);
     d_aux_8i_buffer_2.resize(d_fecframe_len);
 
-    // Initialize the pool of XFECFRAME buffers used for post-decoder SNR estimation
-    for (size_t i = 0; i < d_xfecframe_buffer_pool.size(); i++) {
-        d_xfecframe_saved[i] = std::numeric_limits<uint64_t>::max();
-        d_xfecframe_buffer_pool[i].resize(d_xfecframe_len);
-    }
+    // Initialize the pool of XFECFRAME buffers used for post-decoder SNR estimation,
+    // with the same SIMD batch size selection as the LDPC decoder
+#ifdef CPU_FEATURES_ARCH_X86
+    const X86Features features = GetX86Info().features;
+    const int ldpc_simd_size = features.avx512bw ? 64 : (features.avx2 ? 32 : 16);
+#else
+    const int ldpc_simd_size = 16;
+#endif
+    const size_t pool_size = XFECFRAME_POOL_BATCHES * ldpc_simd_size;
+    d_xfecframe_saved.assign(pool_size, std::numeric_limits<uint64_t>::max());
+    d_xfecframe_buffer_pool.resize(pool_size);
+    for (auto& buffer : d_xfecframe_buffer_pool)
+        buffer.resize(d_xfecframe_len);
 
     // Frame-by-frame processing is convenient
     set_output_multiple(d_fecframe_len);
@@ -13,23 +13,20 @@
 #include "qpsk.h"
 #include <gnuradio/dvbs2rx/xfecframe_demapper_cb.h>
 #include <volk/volk_alloc.hh>
-#include <array>
+#include <vector>
 
 namespace gr {
 namespace dvbs2rx {
 
-// Store enough XFECFRAMEs in a pool to measure the post-decoder SNR. Assume the LDPC
-// decoder will typically process a single SIMD batch at a time, and that it is unlikely
-// we need to store more than two SIMD batches here. On an x86 machine, which could be
-// running AVX2 with a SIMD batch of 32 frames, store 64 XFECFRAMEs. On an ARM processor,
-// which could have ARM Neon with a batch of 16, store 32 XFECFRAMEs. Note this can use
-// quite a bit of memory. For instance, with n_mod=2 and normal FECFRAMEs, the XFECFRAME
-// has 32400 complex symbols, so a 64-frame pool would use 32400*64*8 ~= 15.8 MB.
-#ifdef CPU_FEATURES_ARCH_ANY_ARM
-#define XFECFRAME_POOL_SIZE 32
-#else
-#define XFECFRAME_POOL_SIZE 64
-#endif
+// Store enough XFECFRAMEs in a pool to measure the post-decoder SNR. Assume each LLR
+// PDU from the LDPC decoder holds at most one SIMD batch, and that the demapper runs
+// ahead of the decoder by no more than another batch. Hence, store two SIMD batches,
+// sized for the widest batch the LDPC decoder selects at runtime on this CPU: 128
+// XFECFRAMEs with AVX-512, 64 with AVX2, and 32 otherwise (e.g., SSE4.1 or ARM Neon).
+// Note this can use quite a bit of memory. For instance, with n_mod=2 and normal
+// FECFRAMEs, the XFECFRAME has 32400 complex symbols, so a 128-frame pool would use
+// 32400*128*8 ~= 31.6 MB.
+#define XFECFRAME_POOL_BATCHES 2
 
 class xfecframe_demapper_cb_impl : public xfecframe_demapper_cb
 {
@@ -52,8 +49,8 @@ private:
     gr::thread::mutex d_mutex;
 
     // Used for measuring the post-decoder SNR using the LLRs reported by the LDPC decoder
-    std::array<volk::vector<gr_complex>, XFECFRAME_POOL_SIZE> d_xfecframe_buffer_pool;
-    std::array<uint64_t, XFECFRAME_POOL_SIZE> d_xfecframe_saved;
+    std::vector<volk::vector<gr_complex>> d_xfecframe_buffer_pool;
+    std::vector<uint64_t> d_xfecframe_saved;
     size_t d_idx_xfecframe_buffer; /**< Index to the next XFECFRAME bufer */
     const pmt::pmt_t d_pdu_port_id = pmt::mp("llr_pdu");
     void handle_llr_pdu(pmt::pmt_t pdu);
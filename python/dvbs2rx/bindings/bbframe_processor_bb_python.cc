@@ -0,0 +1,74 @@
+/*
+ * Copyright 2020 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ */
+
+/***********************************************************************************/
+/* This file is automatically generated using bindtool and can be manually edited  */
+/* The following lines can be configured to regenerate this file during cmake      */
+/* If manual edits are made, the following tags should be modified accordingly.    */
+/* BINDTOOL_GEN_AUTOMATIC(0)                                                       */
+/* BINDTOOL_USE_PYGCCXML(0)                                                        */
+/* BINDTOOL_HEADER_FILE(bbframe_processor_bb.h)                                    */
+/* BINDTOOL_HEADER_FILE_HASH(0516577c4840caa5ea4ba029fa6c0b25)                     */
+/***********************************************************************************/
+
+#include <pybind11/complex.h>
+#include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
+
+namespace py = pybind11;
+
+#include <gnuradio/dvbs2rx/bbframe_processor_bb.h>
+// pydoc.h is automatically generated in the build directory
+#include <bbframe_processor_bb_pydoc.h>
+
+void bind_bbframe_processor_bb(py::module& m)
+{
+
+    using bbframe_processor_bb = ::gr::dvbs2rx::bbframe_processor_bb;
+
+
+    py::class_<bbframe_processor_bb,
+               gr::block,
+               gr::basic_block,
+               std::shared_ptr<bbframe_processor_bb>>(
+        m, "bbframe_processor_bb", D(bbframe_processor_bb))
+
+        .def(py::init(&bbframe_processor_bb::make),
+             py::arg("standard"),
+             py::arg("framesize"),
+             py::arg("rate"),
+             py::arg("debug_level") = 0,
+             D(bbframe_processor_bb, make))
+
+        .def("get_frame_count",
+             &bbframe_processor_bb::get_frame_count,
+             D(bbframe_processor_bb, get_frame_count))
+
+        .def("get_frame_error_count",
+             &bbframe_processor_bb::get_frame_error_count,
+             D(bbframe_processor_bb, get_frame_error_count))
+
+        .def("get_packet_count",
+             &bbframe_processor_bb::get_packet_count,
+             D(bbframe_processor_bb, get_packet_count))
+
+        .def("get_packet_error_count",
+             &bbframe_processor_bb::get_packet_error_count,
+             D(bbframe_processor_bb, get_packet_error_count))
+
+        .def("get_bbframe_count",
+             &bbframe_processor_bb::get_bbframe_count,
+             D(bbframe_processor_bb, get_bbframe_count))
+
+        .def("get_bbframe_drop_count",
+             &bbframe_processor_bb::get_bbframe_drop_count,
+             D(bbframe_processor_bb, get_bbframe_drop_count))
+
+        ;
+}
@@ -14,7 +14,7 @@
 /* BINDTOOL_GEN_AUTOMATIC(0)                                                       */
 /* BINDTOOL_USE_PYGCCXML(0)                                                        */
 /* BINDTOOL_HEADER_FILE(bch_decoder_bb.h)                                        */
-/* BINDTOOL_HEADER_FILE_HASH(9ce4730363a1d64d74e5458847ad1f1a)                     */
+/* BINDTOOL_HEADER_FILE_HASH(3967f989f818f2e98f0f5f07f9d70d1a)                     */
 /***********************************************************************************/
 
 #include <pybind11/complex.h>
@@ -44,6 +44,7 @@ void bind_bch_decoder_bb(py::module& m)
              py::arg("rate"),
              py::arg("outputmode"),
              py::arg("debug_level") = 0,
+             py::arg("num_threads") = 1,
              D(bch_decoder_bb, make))
 
         .def("get_frame_count",
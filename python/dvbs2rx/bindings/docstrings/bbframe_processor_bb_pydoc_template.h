@@ -0,0 +1,43 @@
+/*
+ * Copyright 2020 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ */
+#include "pydoc_macros.h"
+#define D(...) DOC(gr, dvbs2rx, __VA_ARGS__)
+/*
+  This file contains placeholders for docstrings for the Python bindings.
+  Do not edit! These were automatically extracted during the binding process
+  and will be overwritten during the build process
+ */
+
+
+
+static const char* __doc_gr_dvbs2rx_bbframe_processor_bb = R"doc()doc";
+
+
+static const char* __doc_gr_dvbs2rx_bbframe_processor_bb_bbframe_processor_bb = R"doc()doc";
+
+
+static const char* __doc_gr_dvbs2rx_bbframe_processor_bb_make = R"doc()doc";
+
+
+static const char* __doc_gr_dvbs2rx_bbframe_processor_bb_get_frame_count = R"doc()doc";
+
+
+static const char* __doc_gr_dvbs2rx_bbframe_processor_bb_get_frame_error_count = R"doc()doc";
+
+
+static const char* __doc_gr_dvbs2rx_bbframe_processor_bb_get_packet_count = R"doc()doc";
+
+
+static const char* __doc_gr_dvbs2rx_bbframe_processor_bb_get_packet_error_count = R"doc()doc";
+
+
+static const char* __doc_gr_dvbs2rx_bbframe_processor_bb_get_bbframe_count = R"doc()doc";
+
+
+static const char* __doc_gr_dvbs2rx_bbframe_processor_bb_get_bbframe_drop_count = R"doc()doc";
@@ -25,3 +25,6 @@ static const char* __doc_gr_dvbs2rx_ldpc_decoder_bb_make = R"doc()doc";
 
 
 static const char* __doc_gr_dvbs2rx_ldpc_decoder_bb_get_average_trials = R"doc()doc";
+
+
+static const char* __doc_gr_dvbs2rx_ldpc_decoder_bb_get_trials_cap = R"doc()doc";
@@ -14,7 +14,7 @@
 /* BINDTOOL_GEN_AUTOMATIC(0)                                                       */
 /* BINDTOOL_USE_PYGCCXML(0)                                                        */
 /* BINDTOOL_HEADER_FILE(dvb_config.h)                                        */
-/* BINDTOOL_HEADER_FILE_HASH(6b4f50866cfad992a0afe38a39e0a0e4)                     */
+/* BINDTOOL_HEADER_FILE_HASH(dc44341f31191f49125730d7fb692493)                     */
 /***********************************************************************************/
 
 #include <pybind11/complex.h>
@@ -132,4 +132,20 @@ void bind_dvb_config(py::module& m)
         .value("INFO_OFF", ::gr::dvbs2rx::INFO_OFF) // 0
         .value("INFO_ON", ::gr::dvbs2rx::INFO_ON)   // 1
         .export_values();
+    py::enum_<::gr::dvbs2rx::dvb_ldpc_schedule_t>(m, "dvb_ldpc_schedule_t")
+        .value("LDPC_LAYERED", ::gr::dvbs2rx::LDPC_LAYERED)   // 0
+        .value("LDPC_FLOODING", ::gr::dvbs2rx::LDPC_FLOODING) // 1
+        .export_values();
+    py::enum_<::gr::dvbs2rx::dvb_ldpc_precision_t>(m, "dvb_ldpc_precision_t")
+        .value("LDPC_PRECISION_AUTO", ::gr::dvbs2rx::LDPC_PRECISION_AUTO)   // 0
+        .value("LDPC_PRECISION_INT8", ::gr::dvbs2rx::LDPC_PRECISION_INT8)   // 1
+        .value("LDPC_PRECISION_INT16", ::gr::dvbs2rx::LDPC_PRECISION_INT16) // 2
+        .export_values();
+    py::enum_<::gr::dvbs2rx::dvb_ldpc_algorithm_t>(m, "dvb_ldpc_algorithm_t")
+        .value("LDPC_OFFSET_MIN_SUM", ::gr::dvbs2rx::LDPC_OFFSET_MIN_SUM) // 0
+        .value("LDPC_NORMALIZED_MIN_SUM",
+               ::gr::dvbs2rx::LDPC_NORMALIZED_MIN_SUM) // 1
+        .value("LDPC_SELF_CORRECTED_MIN_SUM",
+               ::gr::dvbs2rx::LDPC_SELF_CORRECTED_MIN_SUM) // 2
+        .export_values();
 }
@@ -14,7 +14,7 @@
 /* BINDTOOL_GEN_AUTOMATIC(0)                                                       */
 /* BINDTOOL_USE_PYGCCXML(0)                                                        */
 /* BINDTOOL_HEADER_FILE(ldpc_decoder_bb.h)                                        */
-/* BINDTOOL_HEADER_FILE_HASH(6600d4874aba2dd3820976811b5e2cee)                     */
+/* BINDTOOL_HEADER_FILE_HASH(b965f95a2aaec2dfc4e3845ed29d75cb)                     */
 /***********************************************************************************/
 
 #include <pybind11/complex.h>
@@ -47,11 +47,30 @@ void bind_ldpc_decoder_bb(py::module& m)
              py::arg("infomode"),
              py::arg("max_trials"),
              py::arg("debug_level") = 0,
+             py::arg("batch_timeout_ms") = -1,
+             py::arg("num_threads") = 1,
+             py::arg("acm_vcm") = false,
+             py::arg("pls_filter_lo") = 0xFFFFFFFFFFFFFFFF,
+             py::arg("pls_filter_hi") = 0xFFFFFFFFFFFFFFFF,
+             py::arg("schedule") = ::gr::dvbs2rx::LDPC_LAYERED,
+             py::arg("llr_pdu_period") = 1,
+             py::arg("llr_pdu_frames") = 0,
+             py::arg("precision") = ::gr::dvbs2rx::LDPC_PRECISION_AUTO,
+             py::arg("algorithm") = ::gr::dvbs2rx::LDPC_OFFSET_MIN_SUM,
+             py::arg("offset") = 1.0,
+             py::arg("factor") = 0.875,
+             py::arg("min_trials") = 0,
+             py::arg("trials_backlog") = 0,
+             py::arg("frame_stats") = false,
              D(ldpc_decoder_bb, make))
 
         .def("get_average_trials",
              &ldpc_decoder_bb::get_average_trials,
              D(ldpc_decoder_bb, get_average_trials))
 
+        .def("get_trials_cap",
+             &ldpc_decoder_bb::get_trials_cap,
+             D(ldpc_decoder_bb, get_trials_cap))
+
         ;
 }
@@ -23,6 +23,7 @@ namespace py = pybind11;
 // BINDING_FUNCTION_PROTOTYPES(
 void bind_bbdeheader_bb(py::module& m);
 void bind_bbdescrambler_bb(py::module& m);
+void bind_bbframe_processor_bb(py::module& m);
 void bind_bch_decoder_bb(py::module& m);
 void bind_dvb_config(py::module& m);
 void bind_dvbs2_config(py::module& m);
@@ -62,6 +63,7 @@ PYBIND11_MODULE(dvbs2rx_python, m)
     // BINDING_FUNCTION_CALLS(
     bind_bbdeheader_bb(m);
     bind_bbdescrambler_bb(m);
+    bind_bbframe_processor_bb(m);
     bind_bch_decoder_bb(m);
     bind_dvb_config(m);
     bind_dvbs2_config(m);
@@ -0,0 +1,102 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+#
+# Copyright (c) 2024 Igor Freire.
+#
+# SPDX-License-Identifier: GPL-3.0-or-later
+#
+from math import ceil, floor
+
+import numpy as np
+from gnuradio import blocks, dtv, gr, gr_unittest
+from qa_bbdeheader_bb import UPL_BYTES, gen_bbframe_stream, gen_up_stream
+
+try:
+    from gnuradio.dvbs2rx import (C1_4, FECFRAME_NORMAL, STANDARD_DVBS2,
+                                  bbframe_processor_bb)
+except ImportError:
+    from python.dvbs2rx import (C1_4, FECFRAME_NORMAL, STANDARD_DVBS2,
+                                bbframe_processor_bb)
+
+KBCH = 16008  # QPSK 1/4 with normal fecframe
+NBCH = 16200
+T_BCH = 12  # error correction capability
+
+
+class qa_bbframe_processor_bb(gr_unittest.TestCase):
+
+    def setUp(self):
+        self.tb = gr.top_block()
+
+    def tearDown(self):
+        self.tb = None
+
+    def _set_up_flowgraph(self, bbframe_stream, n_bit_errors):
+        """Set up the flowgraph
+
+        Vector Source -> Unpack -> BB Scrambler -> BCH Encoder -> XOR Errors ->
+        Pack -> BBFRAME Processor -> Vector Sink
+
+        Args:
+            bbframe_stream (bytes): Unscrambled BBFRAMEs to transmit.
+            n_bit_errors (int): Number of bit errors to inject on each BCH
+                codeword.
+        """
+        n_bbframes = len(bbframe_stream) // (KBCH // 8)
+        errors = np.zeros(n_bbframes * NBCH, dtype=np.uint8)
+        for i in range(n_bbframes):
+            idx = np.random.choice(NBCH, n_bit_errors, replace=False)
+            errors[i * NBCH + idx] = 1
+
+        src = blocks.vector_source_b(tuple(bbframe_stream))
+        unpack = blocks.packed_to_unpacked_bb(1, gr.GR_MSB_FIRST)
+        scrambler = dtv.dvb_bbscrambler_bb(dtv.STANDARD_DVBS2,
+                                           dtv.FECFRAME_NORMAL, dtv.C1_4)
+        bch_encoder = dtv.dvb_bch_bb(dtv.STANDARD_DVBS2, dtv.FECFRAME_NORMAL,
+                                     dtv.C1_4)
+        error_src = blocks.vector_source_b(tuple(errors))
+        channel = blocks.xor_bb()
+        pack = blocks.unpacked_to_packed_bb(1, gr.GR_MSB_FIRST)
+        self.processor = bbframe_processor_bb(STANDARD_DVBS2, FECFRAME_NORMAL,
+                                              C1_4)
+        self.sink = blocks.vector_sink_b()
+        self.tb.connect(src, unpack, scrambler, bch_encoder, (channel, 0))
+        self.tb.connect(error_src, (channel, 1))
+        self.tb.connect(channel, pack, self.processor, self.sink)
+
+    def _run_and_check(self, n_bbframes, n_bit_errors):
+        """Process a stream of BBFRAMEs and check the output UPs
+
+        Args:
+            n_bbframes (int): Number of BBFRAMEs to generate.
+            n_bit_errors (int): Number of bit errors on each BCH codeword.
+        """
+        dfl_bytes = (KBCH - 80) // 8
+        n_ups = int(ceil(n_bbframes * dfl_bytes / UPL_BYTES))
+        n_full_ups = int(floor(n_bbframes * dfl_bytes / UPL_BYTES))
+        up_stream = gen_up_stream(n_ups)
+        bbframe_stream = gen_bbframe_stream(KBCH, n_bbframes, up_stream)
+
+        self._set_up_flowgraph(bbframe_stream, n_bit_errors)
+        self.tb.run()
+
+        expected_out = list(up_stream[:n_full_ups * UPL_BYTES])
+        self.assertListEqual(expected_out, self.sink.data())
+        self.assertEqual(self.processor.get_frame_count(), n_bbframes)
+        self.assertEqual(self.processor.get_frame_error_count(), 0)
+        self.assertEqual(self.processor.get_bbframe_count(), n_bbframes)
+        self.assertEqual(self.processor.get_bbframe_drop_count(), 0)
+        self.assertEqual(self.processor.get_packet_count(), n_full_ups)
+        self.assertEqual(self.processor.get_packet_error_count(), 0)
+
+    def test_error_free_bbframes(self):
+        """Test processing of error-free BCH codewords"""
+        self._run_and_check(n_bbframes=10, n_bit_errors=0)
+
+    def test_correctable_bbframes(self):
+        """Test processing of BCH codewords with correctable errors"""
+        self._run_and_check(n_bbframes=10, n_bit_errors=T_BCH)
+
+
+if __name__ == '__main__':
+    gr_unittest.run(qa_bbframe_processor_bb)